@@ -0,0 +1,38 @@
+/*
+ * alloc.c - Allocations du jeu et crochet d'observation
+ */
+
+#include "include/alloc.h"
+#include <stdlib.h>
+
+static AllocHook alloc_hook = NULL;
+static void *alloc_user = NULL;
+
+/*
+ * Installe le crochet d'allocation
+ */
+void alloc_set_hook(AllocHook hook, void *user)
+{
+    alloc_hook = hook;
+    alloc_user = user;
+}
+
+/*
+ * Alloue de la mémoire en prévenant le crochet
+ */
+void *alloc_malloc(size_t size)
+{
+    if (alloc_hook != NULL)
+    {
+        alloc_hook(alloc_user, size);
+    }
+    return malloc(size);
+}
+
+/*
+ * Libère de la mémoire
+ */
+void alloc_free(void *ptr)
+{
+    free(ptr);
+}
@@ -9,38 +9,117 @@
  */
 
 #include "include/game.h"
+#include "include/alloc.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+
+/*
+ * Vide la grille d'occupation et le plan de couleurs
+ */
+static void grid_clear(GameState *game)
+{
+    memset(game->grid_rows, 0, sizeof(game->grid_rows));
+    memset(game->grid_colors, 0, sizeof(game->grid_colors));
+    memset(game->column_heights, 0, sizeof(game->column_heights));
+    game->ghost_valid = false;
+
+    // Toute la grille est à redessiner
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        game->dirty_rows[y] = GRID_ROW_FULL;
+    }
+}
+
+/*
+ * Gravité d'un niveau: `level` cases par seconde, en sous-cases par tick
+ *
+ * Courbe linéaire d'origine. Sans délai de verrouillage, une pièce
+ * posée se fixe aussitôt: une courbe plus raide (Guideline) rendrait
+ * les hauts niveaux injouables. Le plafond GRAVITY_MAX (20G) n'est
+ * qu'une borne de sûreté (atteinte au niveau 1200); une pièce tombe
+ * de plusieurs cases par tick au-delà de 1G (niveau 60).
+ */
+static int32_t gravity_for_level(int level)
+{
+    int32_t gravity = (int32_t)level * (GRAVITY_SUBCELLS / SIM_TICK_RATE);
+    return (gravity > GRAVITY_MAX) ? GRAVITY_MAX : gravity;
+}
+
+/*
+ * Met à jour les hauteurs de colonnes après suppression de lignes
+ *
+ * Chaque colonne perd au moins `lines` de hauteur (les lignes supprimées
+ * étaient pleines); si son nouveau sommet est un trou, on descend
+ * jusqu'au premier bloc.
+ */
+static void heights_after_clear(GameState *game, int lines)
+{
+    for (int x = 0; x < GRID_WIDTH; x++)
+    {
+        int h = game->column_heights[x] - lines;
+        if (h < 0)
+            h = 0;
+
+        while (h > 0 && !(game->grid_rows[GRID_HEIGHT - h] & ((GridRow)1 << x)))
+        {
+            h--;
+        }
+
+        game->column_heights[x] = h;
+    }
+}
+
+/*
+ * Supprime la ligne y de la grille et descend les lignes au-dessus
+ *
+ * Les masques et les couleurs sont décalés d'un cran vers le bas,
+ * la ligne du haut devient vide.
+ */
+static void grid_remove_row(GameState *game, int y)
+{
+    memmove(&game->grid_rows[1], &game->grid_rows[0], y * sizeof(GridRow));
+    memmove(&game->grid_colors[1], &game->grid_colors[0], y * sizeof(game->grid_colors[0]));
+    game->grid_rows[0] = 0;
+    memset(game->grid_colors[0], 0, sizeof(game->grid_colors[0]));
+}
 
 /*
  * Initialise un nouveau jeu
  */
-GameState *game_init(void)
+GameState *game_init(uint64_t seed)
 {
-    GameState *game = (GameState *)malloc(sizeof(GameState));
+    GameState *game = (GameState *)alloc_malloc(sizeof(GameState));
     if (game == NULL)
     {
         fprintf(stderr, "Erreur: Impossible d'allouer GameState\n");
         return NULL;
     }
 
+    // Grille vide
+    grid_clear(game);
+
+    // Réserver les blocs d'une grille pleine (+ la pièce qui se fixe)
+    // pour que le pool n'ait plus à allouer pendant la partie
+    if (!list_pool_reserve(GRID_WIDTH * GRID_HEIGHT + PIECE_BLOCKS))
+    {
+        alloc_free(game);
+        return NULL;
+    }
+
     // Initialiser la liste des blocs fixés
     game->fixed_blocks = list_create();
     if (game->fixed_blocks == NULL)
     {
-        free(game);
+        alloc_free(game);
         return NULL;
     }
 
     // Créer les pièces initiales
-    game->current_piece = piece_create_random();
-    game->next_piece = piece_create_random();
-
-    if (game->current_piece == NULL || game->next_piece == NULL)
-    {
-        game_destroy(game);
-        return NULL;
-    }
+    game->seed = seed;
+    piece_bag_init(&game->bag, seed);
+    piece_init_random(&game->current_piece, &game->bag);
+    piece_init_random(&game->next_piece, &game->bag);
 
     // Initialiser les statistiques
     game->score = 0;
@@ -48,8 +127,14 @@ GameState *game_init(void)
     game->lines_cleared = 0;
     game->game_over = false;
     game->paused = false;
-    game->fall_timer = 0.0f;
-    game->fall_speed = 1.0f; // 1 seconde par chute au niveau 1
+    game->tick = 0;
+    game->gravity = gravity_for_level(1); // 1 case par seconde au niveau 1
+    game->gravity_accum = 0;
+    game->last_kick = 0;
+
+    // Aucun crochet d'événements par défaut
+    game->event_hook = NULL;
+    game->event_user = NULL;
 
     return game;
 }
@@ -67,37 +152,21 @@ void game_destroy(GameState *game)
         list_destroy(game->fixed_blocks);
     }
 
-    if (game->current_piece != NULL)
-    {
-        piece_destroy(game->current_piece);
-    }
-
-    if (game->next_piece != NULL)
-    {
-        piece_destroy(game->next_piece);
-    }
-
-    free(game);
+    alloc_free(game);
 }
 
 /*
- * Vérifie si une pièce entre en collision
+ * Vérifie si des blocs placés à l'origine (x, y) entrent en collision
  *
- * On parcourt chaque bloc de la pièce et on vérifie:
- * 1. S'il sort de la grille (limites)
- * 2. S'il chevauche un bloc fixé
+ * Cœur commun aux tests de collision: il travaille directement sur une
+ * forme (pièce ou ligne de la table des rotations), sans copier de pièce.
  */
-bool game_check_collision(Piece *piece, BlockList *fixed_blocks, int dx, int dy)
+static bool cells_collide(GameState *game, const PieceCell *cells, int x, int y)
 {
-    if (piece == NULL || piece->blocks == NULL)
-        return true;
-
-    Block *current = piece->blocks->head;
-
-    while (current != NULL)
+    for (int i = 0; i < PIECE_BLOCKS; i++)
     {
-        int new_x = current->x + dx;
-        int new_y = current->y + dy;
+        int new_x = x + cells[i].x;
+        int new_y = y + cells[i].y;
 
         // Vérifier les limites de la grille
         if (new_x < 0 || new_x >= GRID_WIDTH)
@@ -114,32 +183,63 @@ bool game_check_collision(Piece *piece, BlockList *fixed_blocks, int dx, int dy)
         // Note: on ignore les blocs au-dessus de la grille (y < 0)
         if (new_y >= 0)
         {
-            if (list_find(fixed_blocks, new_x, new_y) != NULL)
+            if (game->grid_rows[new_y] & ((GridRow)1 << new_x))
             {
                 return true; // Collision avec un bloc fixé
             }
         }
-
-        current = current->next;
     }
 
     return false; // Pas de collision
 }
 
+/*
+ * Signale un événement au crochet, s'il y en a un
+ */
+static void game_emit(GameState *game, GameEvent event, int value)
+{
+    if (game->event_hook != NULL)
+    {
+        game->event_hook(game->event_user, event, value);
+    }
+}
+
+/*
+ * Vérifie si une pièce entre en collision
+ *
+ * On parcourt chaque bloc de la pièce et on vérifie:
+ * 1. S'il sort de la grille (limites)
+ * 2. S'il chevauche un bloc fixé (bit correspondant dans grid_rows)
+ */
+bool game_check_collision(GameState *game, Piece *piece, int dx, int dy)
+{
+    if (game == NULL || piece == NULL)
+        return true;
+
+    return cells_collide(game, piece->cells, piece->x + dx, piece->y + dy);
+}
+
 /*
  * Déplace la pièce courante
  */
 bool game_move_piece(GameState *game, int dx, int dy)
 {
-    if (game == NULL || game->current_piece == NULL)
+    if (game == NULL)
         return false;
     if (game->game_over || game->paused)
         return false;
 
     // Vérifier si le mouvement est possible
-    if (!game_check_collision(game->current_piece, game->fixed_blocks, dx, dy))
+    if (!game_check_collision(game, &game->current_piece, dx, dy))
     {
-        piece_move(game->current_piece, dx, dy);
+        piece_move(&game->current_piece, dx, dy);
+
+        // Une descente garde le cache du fantôme valide
+        if (dx != 0)
+            game->ghost_valid = false;
+        else
+            game->ghost_distance -= dy;
+
         return true;
     }
 
@@ -153,60 +253,55 @@ bool game_move_piece(GameState *game, int dx, int dy)
 }
 
 /*
- * Fait tourner la pièce courante
+ * Fait tourner la pièce courante (Super Rotation System)
  *
  * Algorithme:
- * 1. Créer une copie de la pièce
- * 2. Faire tourner la copie
- * 3. Vérifier les collisions
- * 4. Si OK, appliquer la rotation à la vraie pièce
- * 5. Si collision, essayer des ajustements (wall kicks)
+ * 1. Lire la forme de l'état d'arrivée dans la table des rotations
+ * 2. Lire la liste des décalages (wall kicks) pour ce type, cet état
+ *    de départ et ce sens
+ * 3. Tester chaque décalage directement contre la grille
+ * 4. Au premier qui passe, appliquer rotation et décalage à la pièce
+ *
+ * Aucune pièce de test n'est construite: le coût ne dépend que du
+ * nombre de décalages essayés (au plus KICK_MAX_TESTS).
  */
-bool game_rotate_piece(GameState *game)
+bool game_rotate_piece(GameState *game, RotationDirection direction)
 {
-    if (game == NULL || game->current_piece == NULL)
+    if (game == NULL)
         return false;
     if (game->game_over || game->paused)
         return false;
 
-    // Créer une copie pour tester
-    Piece *test_piece = piece_copy(game->current_piece);
-    if (test_piece == NULL)
-        return false;
+    Piece *piece = &game->current_piece;
+    int to = (piece->rotation + direction) & 3;
+    const PieceCell *shape = piece_get_shape(piece->type, to);
 
-    // Appliquer la rotation à la copie
-    piece_rotate(test_piece);
+    int kick_count;
+    const PieceCell *kicks = piece_get_kicks(piece->type, piece->rotation,
+                                             direction, &kick_count);
 
-    // Vérifier si la rotation est possible
-    if (!game_check_collision(test_piece, game->fixed_blocks, 0, 0))
+    for (int i = 0; i < kick_count; i++)
     {
-        // Rotation OK! Appliquer à la vraie pièce
-        piece_rotate(game->current_piece);
-        piece_destroy(test_piece);
-        return true;
-    }
+        int x = piece->x + kicks[i].x;
+        int y = piece->y + kicks[i].y;
 
-    // Essayer des ajustements (wall kicks)
-    // Essai 1: Décaler à droite
-    if (!game_check_collision(test_piece, game->fixed_blocks, 1, 0))
-    {
-        piece_rotate(game->current_piece);
-        piece_move(game->current_piece, 1, 0);
-        piece_destroy(test_piece);
-        return true;
-    }
+        if (!cells_collide(game, shape, x, y))
+        {
+            piece_rotate(piece, direction);
+            piece->x = x;
+            piece->y = y;
+            game->ghost_valid = false;
 
-    // Essai 2: Décaler à gauche
-    if (!game_check_collision(test_piece, game->fixed_blocks, -1, 0))
-    {
-        piece_rotate(game->current_piece);
-        piece_move(game->current_piece, -1, 0);
-        piece_destroy(test_piece);
-        return true;
+            game->last_kick = i;
+            if (i > 0)
+            {
+                game_emit(game, GAME_EVENT_KICK, i);
+            }
+            return true;
+        }
     }
 
     // Rotation impossible
-    piece_destroy(test_piece);
     return false;
 }
 
@@ -221,21 +316,36 @@ bool game_rotate_piece(GameState *game)
  */
 void game_fix_piece(GameState *game)
 {
-    if (game == NULL || game->current_piece == NULL)
+    if (game == NULL)
         return;
 
-    // Transférer les blocs de la pièce vers fixed_blocks
-    Block *current = game->current_piece->blocks->head;
-    while (current != NULL)
+    // Transférer les blocs de la pièce vers la grille et fixed_blocks
+    Piece *piece = &game->current_piece;
+    for (int i = 0; i < PIECE_BLOCKS; i++)
     {
-        list_add(game->fixed_blocks, current->x, current->y, current->color);
-        current = current->next;
+        int x = piece->x + piece->cells[i].x;
+        int y = piece->y + piece->cells[i].y;
+
+        if (y >= 0 && y < GRID_HEIGHT)
+        {
+            game->grid_rows[y] |= (GridRow)1 << x;
+            game->grid_colors[y][x] = piece->color;
+            game->dirty_rows[y] |= (GridRow)1 << x;
+
+            if (GRID_HEIGHT - y > game->column_heights[x])
+                game->column_heights[x] = GRID_HEIGHT - y;
+        }
+        list_add(game->fixed_blocks, x, y, piece->color);
     }
+    game_emit(game, GAME_EVENT_LOCK, piece->type);
 
     // Vérifier et supprimer les lignes complètes
     int lines = game_check_lines(game);
     if (lines > 0)
     {
+        game_emit(game, GAME_EVENT_LINES, lines);
+        heights_after_clear(game, lines);
+
         // Calcul du score (scoring Tetris classique)
         int points[] = {0, 40, 100, 300, 1200}; // 0, 1, 2, 3, 4 lignes
         game->score += points[lines] * game->level;
@@ -243,25 +353,23 @@ void game_fix_piece(GameState *game)
 
         // Augmenter le niveau tous les 10 lignes
         game->level = 1 + (game->lines_cleared / 10);
-        game->fall_speed = 1.0f / game->level; // Vitesse augmente avec le niveau
+        game->gravity = gravity_for_level(game->level); // Vitesse augmente avec le niveau
     }
 
-    // Détruire l'ancienne pièce
-    piece_destroy(game->current_piece);
-
     // La prochaine pièce devient la courante
     game->current_piece = game->next_piece;
-    game->next_piece = piece_create_random();
+    piece_init_random(&game->next_piece, &game->bag);
+    game->ghost_valid = false;
 
     // Vérifier si la nouvelle pièce entre en collision (game over)
-    if (game_check_collision(game->current_piece, game->fixed_blocks, 0, 0))
+    if (game_check_collision(game, &game->current_piece, 0, 0))
     {
         game->game_over = true;
-        printf("GAME OVER! Score final: %d\n", game->score);
+        game_emit(game, GAME_EVENT_GAME_OVER, game->score);
     }
 
-    // Réinitialiser le timer de chute
-    game->fall_timer = 0.0f;
+    // Réinitialiser l'accumulateur de chute
+    game->gravity_accum = 0;
 }
 
 /*
@@ -269,9 +377,9 @@ void game_fix_piece(GameState *game)
  *
  * Algorithme:
  * 1. Pour chaque ligne Y de bas en haut
- * 2. Compter combien de blocs ont cette coordonnée Y
- * 3. Si count == 10 (ligne pleine):
- *    a. Supprimer tous les blocs de cette ligne
+ * 2. Comparer son masque d'occupation à GRID_ROW_FULL
+ * 3. Si la ligne est pleine:
+ *    a. Supprimer tous les blocs de cette ligne (seau de la ligne)
  *    b. Descendre tous les blocs au-dessus (y < Y)
  * 4. Revérifier la même ligne (car les blocs ont descendu)
  */
@@ -285,72 +393,81 @@ int game_check_lines(GameState *game)
     // Parcourir de bas en haut
     for (int y = GRID_HEIGHT - 1; y >= 0; y--)
     {
-        int count = 0;
+        // Ligne complète?
+        if (game->grid_rows[y] != GRID_ROW_FULL)
+            continue;
 
-        // Compter les blocs sur cette ligne
-        Block *current = game->fixed_blocks->head;
-        while (current != NULL)
-        {
-            if (current->y == y)
-            {
-                count++;
-            }
-            current = current->next;
-        }
+        lines_removed++;
+        grid_remove_row(game, y);
 
-        // Ligne complète?
-        if (count == GRID_WIDTH)
+        // Cette ligne et toutes celles au-dessus ont changé
+        for (int dy = 0; dy <= y; dy++)
         {
-            lines_removed++;
+            game->dirty_rows[dy] = GRID_ROW_FULL;
+        }
 
-            // Supprimer tous les blocs de cette ligne
-            current = game->fixed_blocks->head;
-            while (current != NULL)
-            {
-                Block *next = current->next;
-
-                if (current->y == y)
-                {
-                    // Supprimer ce bloc
-                    list_remove(game->fixed_blocks, current->x, current->y);
-                }
-                else if (current->y < y)
-                {
-                    // Descendre les blocs au-dessus
-                    current->y++;
-                }
-
-                current = next;
-            }
+        // Répercuter sur la liste des blocs fixés: vider la ligne
+        // puis descendre les lignes au-dessus
+        list_remove_row(game->fixed_blocks, y);
+        list_shift_rows_down(game->fixed_blocks, y);
 
-            // Revérifier cette ligne (car elle contient maintenant la ligne au-dessus)
-            y++;
-        }
+        // Revérifier cette ligne (car elle contient maintenant la ligne au-dessus)
+        y++;
     }
 
     return lines_removed;
 }
 
 /*
- * Met à jour la logique du jeu (appelée chaque frame)
+ * Avance la simulation d'un tick
  *
- * Gère la gravité: fait tomber la pièce automatiquement
+ * Gère la gravité: fait tomber la pièce automatiquement, d'autant de
+ * cases que l'accumulateur en contient. La distance jusqu'à l'arrivée
+ * (cache du fantôme) évite de descendre case par case: si la chute
+ * dépasse cette distance, la pièce est posée puis fixée directement.
  */
-void game_update(GameState *game, float delta_time)
+static void game_step(GameState *game)
 {
-    if (game == NULL)
+    game->tick++;
+
+    // Accumuler la gravité du tick
+    game->gravity_accum += game->gravity;
+
+    // Nombre de cases à descendre pendant ce tick
+    int cells = game->gravity_accum / GRAVITY_SUBCELLS;
+    if (cells == 0)
         return;
-    if (game->game_over || game->paused)
+    game->gravity_accum -= cells * GRAVITY_SUBCELLS;
+
+    int distance = game_get_ghost_distance(game);
+    if (cells <= distance)
+    {
+        game_move_piece(game, 0, cells);
         return;
+    }
 
-    // Incrémenter le timer de chute
-    game->fall_timer += delta_time;
+    // La pièce touche le sol pendant ce tick: la poser et la fixer
+    if (distance > 0)
+    {
+        game_move_piece(game, 0, distance);
+    }
+    game_fix_piece(game);
+}
+
+/*
+ * Met à jour la logique du jeu (ticks entiers de simulation)
+ */
+void game_update(GameState *game, int ticks)
+{
+    if (game == NULL)
+        return;
 
-    // Vérifier si c'est le moment de faire tomber la pièce
-    if (game->fall_timer >= game->fall_speed)
+    for (int i = 0; i < ticks; i++)
     {
-        game_move_piece(game, 0, 1); // Descendre d'une case
-        game->fall_timer = 0.0f;
+        if (game->game_over || game->paused)
+            return;
+
+        game_step(game);
     }
 }
 
@@ -359,17 +476,15 @@ void game_update(GameState *game, float delta_time)
  */
 void game_drop_piece(GameState *game)
 {
-    if (game == NULL || game->current_piece == NULL)
+    if (game == NULL)
         return;
     if (game->game_over || game->paused)
         return;
 
-    // Descendre jusqu'à la collision
-    while (!game_check_collision(game->current_piece, game->fixed_blocks, 0, 1))
-    {
-        piece_move(game->current_piece, 0, 1);
-        game->score += 2; // Bonus pour hard drop
-    }
+    // Descendre jusqu'à la collision en une seule fois
+    int distance = game_get_ghost_distance(game);
+    piece_move(&game->current_piece, 0, distance);
+    game->score += 2 * distance; // Bonus pour hard drop
 
     // Fixer immédiatement
     game_fix_piece(game);
@@ -394,21 +509,14 @@ void game_reset(GameState *game)
         return;
 
     // Vider la grille
+    grid_clear(game);
     list_clear(game->fixed_blocks);
 
-    // Détruire les anciennes pièces
-    if (game->current_piece != NULL)
-    {
-        piece_destroy(game->current_piece);
-    }
-    if (game->next_piece != NULL)
-    {
-        piece_destroy(game->next_piece);
-    }
-
-    // Créer de nouvelles pièces
-    game->current_piece = piece_create_random();
-    game->next_piece = piece_create_random();
+    // Créer de nouvelles pièces (nouveau sac)
+    piece_bag_reset(&game->bag);
+    piece_init_random(&game->current_piece, &game->bag);
+    piece_init_random(&game->next_piece, &game->bag);
+    game->ghost_valid = false;
 
     // Réinitialiser les stats
     game->score = 0;
@@ -416,8 +524,59 @@ void game_reset(GameState *game)
     game->lines_cleared = 0;
     game->game_over = false;
     game->paused = false;
-    game->fall_timer = 0.0f;
-    game->fall_speed = 1.0f;
+    game->tick = 0;
+    game->gravity = gravity_for_level(1);
+    game->gravity_accum = 0;
+    game->last_kick = 0;
+}
+
+/*
+ * Calcule la distance de chute de la pièce courante
+ *
+ * Si chaque bloc est au-dessus du sommet de sa colonne, la distance
+ * se lit directement dans column_heights. Sinon (pièce glissée sous un
+ * surplomb), on descend ligne par ligne avec les masques de la grille.
+ */
+int game_get_ghost_distance(GameState *game)
+{
+    if (game == NULL)
+        return 0;
+
+    if (game->ghost_valid)
+        return game->ghost_distance;
+
+    Piece *piece = &game->current_piece;
+    int distance = GRID_HEIGHT;
+    bool above_stack = true;
+
+    for (int i = 0; i < PIECE_BLOCKS; i++)
+    {
+        int x = piece->x + piece->cells[i].x;
+        int y = piece->y + piece->cells[i].y;
+        int top = GRID_HEIGHT - game->column_heights[x]; // 1re ligne occupée
+
+        if (y >= top)
+        {
+            above_stack = false;
+            break;
+        }
+
+        if (top - 1 - y < distance)
+            distance = top - 1 - y;
+    }
+
+    if (!above_stack)
+    {
+        distance = 0;
+        while (!game_check_collision(game, piece, 0, distance + 1))
+        {
+            distance++;
+        }
+    }
+
+    game->ghost_distance = distance;
+    game->ghost_valid = true;
+    return distance;
 }
 
 /*
@@ -426,27 +585,65 @@ void game_reset(GameState *game)
  */
 int game_get_ghost_y(GameState *game)
 {
-    if (game == NULL || game->current_piece == NULL)
+    if (game == NULL)
         return 0;
 
     // Trouver le Y minimum actuel de la pièce
+    Piece *piece = &game->current_piece;
     int min_y = GRID_HEIGHT;
-    Block *current = game->current_piece->blocks->head;
-    while (current != NULL)
+    for (int i = 0; i < PIECE_BLOCKS; i++)
     {
-        if (current->y < min_y)
+        if (piece->y + piece->cells[i].y < min_y)
         {
-            min_y = current->y;
+            min_y = piece->y + piece->cells[i].y;
         }
-        current = current->next;
     }
 
-    // Descendre jusqu'à la collision
-    int ghost_offset = 0;
-    while (!game_check_collision(game->current_piece, game->fixed_blocks, 0, ghost_offset + 1))
-    {
-        ghost_offset++;
-    }
+    return min_y + game_get_ghost_distance(game);
+}
 
-    return min_y + ghost_offset;
-}
\ No newline at end of file
+/*
+ * Installe le crochet d'événements
+ */
+void game_set_event_hook(GameState *game, GameEventHook hook, void *user)
+{
+    if (game == NULL)
+        return;
+
+    game->event_hook = hook;
+    game->event_user = user;
+}
+
+/*
+ * Récupère et efface les cases modifiées
+ */
+void game_take_dirty(GameState *game, GridRow rows[GRID_HEIGHT])
+{
+    if (game == NULL)
+        return;
+
+    memcpy(rows, game->dirty_rows, sizeof(game->dirty_rows));
+    memset(game->dirty_rows, 0, sizeof(game->dirty_rows));
+}
+
+/*
+ * Copie l'état affichable dans un instantané
+ */
+void game_snapshot(GameState *game, GameSnapshot *snapshot)
+{
+    if (game == NULL || snapshot == NULL)
+        return;
+
+    memcpy(snapshot->grid_rows, game->grid_rows, sizeof(snapshot->grid_rows));
+    memcpy(snapshot->grid_colors, game->grid_colors, sizeof(snapshot->grid_colors));
+    snapshot->current_piece = game->current_piece;
+    snapshot->next_piece = game->next_piece;
+    snapshot->ghost_distance = game_get_ghost_distance(game);
+    snapshot->score = game->score;
+    snapshot->level = game->level;
+    snapshot->lines_cleared = game->lines_cleared;
+    snapshot->block_count = game->fixed_blocks->count;
+    snapshot->game_over = game->game_over;
+    snapshot->paused = game->paused;
+    snapshot->tick = game->tick;
+}
@@ -0,0 +1,56 @@
+/*
+ * alloc.h - Allocations du jeu, observables
+ *
+ * Toutes les allocations du cœur (et du front end) passent par
+ * alloc_malloc / alloc_free. Un crochet optionnel est appelé à chaque
+ * allocation: le front end s'en sert pour compter les allocations par
+ * frame, sans que le cœur dépende de SDL ni d'un type atomique.
+ */
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <stddef.h>
+
+/*
+ * AllocHook - Fonction appelée à chaque allocation
+ *
+ * Peut être appelée depuis n'importe quel thread qui alloue: elle doit
+ * être sûre entre threads (compteur atomique...).
+ *
+ * Paramètres:
+ *   user: Pointeur donné à alloc_set_hook
+ *   size: Taille demandée
+ */
+typedef void (*AllocHook)(void *user, size_t size);
+
+/*
+ * alloc_set_hook - Installe le crochet d'allocation
+ *
+ * À appeler avant de lancer d'autres threads.
+ *
+ * Paramètres:
+ *   hook: Fonction appelée à chaque allocation (NULL pour retirer)
+ *   user: Pointeur transmis au crochet
+ */
+void alloc_set_hook(AllocHook hook, void *user);
+
+/*
+ * alloc_malloc - Alloue de la mémoire (comme malloc)
+ *
+ * Paramètres:
+ *   size: Taille en octets
+ *
+ * Retour: La mémoire, NULL en cas d'échec
+ */
+void *alloc_malloc(size_t size);
+
+/*
+ * alloc_free - Libère de la mémoire obtenue par alloc_malloc
+ *
+ * Paramètres:
+ *   ptr: La mémoire (NULL accepté)
+ */
+void alloc_free(void *ptr);
+
+#endif /* ALLOC_H */
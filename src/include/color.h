@@ -0,0 +1,26 @@
+/*
+ * color.h - Type couleur du cœur du jeu
+ *
+ * La logique (list, pieces, game) ne dépend pas de SDL: elle manipule
+ * ce type, converti en SDL_Color seulement au moment du rendu.
+ */
+
+#ifndef COLOR_H
+#define COLOR_H
+
+#include <stdint.h>
+
+/*
+ * Structure Color - Couleur RGBA 8 bits par composante
+ *
+ * Même disposition mémoire que SDL_Color.
+ */
+typedef struct Color
+{
+    uint8_t r; // Rouge
+    uint8_t g; // Vert
+    uint8_t b; // Bleu
+    uint8_t a; // Opacité
+} Color;
+
+#endif /* COLOR_H */
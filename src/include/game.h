@@ -14,47 +14,166 @@
 #include "pieces.h"
 #include "list.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 // Constantes de la grille
 #define GRID_WIDTH 10  // Largeur de la grille (colonnes)
 #define GRID_HEIGHT 20 // Hauteur de la grille (lignes)
 
+/*
+ * GridRow - Masque d'occupation d'une ligne de la grille
+ *
+ * Le bit x vaut 1 si la case (x, y) est occupée par un bloc fixé.
+ * Un mot machine suffit tant que GRID_WIDTH <= 32.
+ */
+typedef uint32_t GridRow;
+
+// Fréquence de la simulation (ticks par seconde)
+#define SIM_TICK_RATE 60
+
+// Une case de chute = GRAVITY_SUBCELLS sous-cases (multiple de
+// SIM_TICK_RATE pour qu'une vitesse entière en cases/s tombe juste)
+#define GRAVITY_SUBCELLS (SIM_TICK_RATE * 1024)
+
+// Gravité maximale: 20 cases par tick (20G), soit une chute instantanée
+// sur toute la hauteur de la grille
+#define GRAVITY_MAX (20 * GRAVITY_SUBCELLS)
+
+// Masque d'une ligne complète (les GRID_WIDTH bits de poids faible à 1)
+#define GRID_ROW_FULL ((GridRow)((1u << GRID_WIDTH) - 1u))
+
+/*
+ * GameEvent - Événements notables de la partie (crochet d'événements)
+ *
+ * - GAME_EVENT_LOCK: Pièce fixée (valeur: type de la pièce)
+ * - GAME_EVENT_LINES: Lignes supprimées (valeur: nombre de lignes)
+ * - GAME_EVENT_GAME_OVER: Fin de partie (valeur: score final)
+ * - GAME_EVENT_KICK: Rotation réussie grâce à un décalage SRS (valeur:
+ *   index du décalage dans la table, 1 ou plus)
+ */
+typedef enum
+{
+    GAME_EVENT_LOCK,
+    GAME_EVENT_LINES,
+    GAME_EVENT_GAME_OVER,
+    GAME_EVENT_KICK
+} GameEvent;
+
+/*
+ * GameEventHook - Fonction appelée à chaque événement de la partie
+ *
+ * Appelée depuis le thread qui fait avancer le jeu, au milieu de la
+ * mise à jour: elle doit rester courte et ne pas modifier le jeu.
+ *
+ * Paramètres:
+ *   user: Pointeur donné à game_set_event_hook
+ *   event: L'événement
+ *   value: Valeur associée (voir GameEvent)
+ */
+typedef void (*GameEventHook)(void *user, GameEvent event, int value);
+
 /*
  * Structure GameState - État complet du jeu
  *
  * Contient toutes les informations nécessaires:
- * - fixed_blocks: Liste de tous les blocs fixés dans la grille
+ * - grid_rows: Occupation de la grille, un masque de bits par ligne
+ *   (collisions et lignes complètes en quelques ET/comparaisons)
+ * - grid_colors: Couleur de chaque case occupée (plan séparé)
+ * - column_heights: Hauteur de la pile dans chaque colonne (skyline),
+ *   mise à jour à chaque fixation et suppression de lignes
+ * - ghost_distance: Distance de chute de la pièce courante, en cache
+ *   tant que ghost_valid est vrai (invalidée par déplacement latéral,
+ *   rotation ou fixation)
+ * - dirty_rows: Cases de la grille modifiées (fixation, lignes
+ *   supprimées, remise à zéro) depuis la dernière lecture
+ *   (game_take_dirty), un masque par ligne comme grid_rows
+ * - fixed_blocks: Liste de tous les blocs fixés (itération uniquement)
  * - current_piece: La pièce actuellement contrôlée par le joueur
  * - next_piece: La prochaine pièce (affichée dans le HUD)
+ * - bag, seed: Générateur des pièces (7-bag) et sa graine
  * - score: Score actuel du joueur
  * - level: Niveau actuel (affecte la vitesse)
  * - lines_cleared: Nombre total de lignes complétées
  * - game_over: Indicateur de fin de partie
  * - paused: Indicateur de pause
+ * - tick, gravity, gravity_accum: Horloge entière de la simulation et
+ *   gravité en virgule fixe (aucun flottant: résultat identique sur
+ *   toutes les machines pour une même suite de ticks et d'entrées)
+ * - last_kick: Décalage SRS utilisé par la dernière rotation réussie
+ *   (0: rotation sur place)
+ * - event_hook, event_user: Crochet d'événements (NULL: aucun)
  */
 typedef struct
 {
+    GridRow grid_rows[GRID_HEIGHT];                 // Occupation par ligne
+    Color grid_colors[GRID_HEIGHT][GRID_WIDTH];     // Couleurs des cases
+    int column_heights[GRID_WIDTH];                 // Hauteur par colonne
+    int ghost_distance;                             // Chute de la pièce (cache)
+    bool ghost_valid;                               // Cache à jour?
+    GridRow dirty_rows[GRID_HEIGHT];                // Cases modifiées
     BlockList *fixed_blocks; // Blocs fixés dans la grille
-    Piece *current_piece;    // Pièce en mouvement
-    Piece *next_piece;       // Prochaine pièce
+    Piece current_piece;     // Pièce en mouvement
+    Piece next_piece;        // Prochaine pièce
+    PieceBag bag;            // Tirage des pièces
+    uint64_t seed;           // Graine du tirage
     int score;               // Score du joueur
     int level;               // Niveau actuel
     int lines_cleared;       // Lignes complétées au total
     bool game_over;          // État de fin de partie
     bool paused;             // État de pause
-    float fall_timer;        // Timer pour la gravité
-    float fall_speed;        // Vitesse de chute (secondes)
+    uint64_t tick;           // Ticks de simulation écoulés
+    int32_t gravity;         // Vitesse de chute (sous-cases par tick)
+    int32_t gravity_accum;   // Sous-cases accumulées depuis la dernière chute
+    int last_kick;           // Décalage de la dernière rotation
+    GameEventHook event_hook; // Crochet d'événements
+    void *event_user;         // Donnée du crochet
 } GameState;
 
+/*
+ * Structure GameSnapshot - Copie compacte et immuable de l'état affiché
+ *
+ * Produite par game_snapshot pour qu'un autre thread (le rendu) lise
+ * l'état du jeu sans toucher à GameState ni à la liste des blocs: tout
+ * est copié par valeur.
+ * - grid_version: change quand le contenu de la grille change (rempli
+ *   par le producteur, voir game_take_dirty); inchangé, la grille est
+ *   identique à celle de l'instantané précédent
+ * - sequence: Numéro de publication (rempli par le producteur): un
+ *   lecteur sait ainsi s'il a déjà affiché cet instantané
+ * - ghost_distance: Distance de chute déjà calculée
+ * - block_count: Nombre de blocs fixés
+ */
+typedef struct
+{
+    GridRow grid_rows[GRID_HEIGHT];
+    Color grid_colors[GRID_HEIGHT][GRID_WIDTH];
+    uint32_t grid_version;
+    uint32_t sequence;
+    Piece current_piece;
+    Piece next_piece;
+    int ghost_distance;
+    int score;
+    int level;
+    int lines_cleared;
+    int block_count;
+    bool game_over;
+    bool paused;
+    uint64_t tick;
+} GameSnapshot;
+
 /*
  * game_init - Initialise un nouveau jeu
  *
  * Crée la grille vide, génère les premières pièces
  * et initialise le score à 0
  *
+ * Paramètres:
+ *   seed: Graine du tirage des pièces (même graine et mêmes entrées =
+ *         même partie)
+ *
  * Retour: Pointeur vers le nouvel état de jeu
  */
-GameState *game_init(void);
+GameState *game_init(uint64_t seed);
 
 /*
  * game_destroy - Détruit le jeu et libère la mémoire
@@ -65,19 +184,25 @@ GameState *game_init(void);
 void game_destroy(GameState *game);
 
 /*
- * game_update - Met à jour la logique du jeu
+ * game_update - Avance la simulation d'un nombre entier de ticks
  *
- * Appelée à chaque frame:
- * - Applique la gravité
+ * Chaque tick (1/SIM_TICK_RATE s):
+ * - Applique la gravité (plusieurs cases par tick aux niveaux élevés,
+ *   jusqu'à 20G: la ligne d'arrivée est lue en une fois dans le cache
+ *   du fantôme au lieu de descendre case par case)
  * - Vérifie les collisions
  * - Fixe les pièces
  * - Vérifie les lignes complètes
  *
+ * L'appelant décide combien de ticks exécuter: autant que le temps
+ * réel écoulé l'exige (boucle de jeu), ou aussi vite que possible
+ * (simulation, relecture).
+ *
  * Paramètres:
  *   game: L'état du jeu
- *   delta_time: Temps écoulé depuis la dernière frame (en secondes)
+ *   ticks: Nombre de ticks à simuler
  */
-void game_update(GameState *game, float delta_time);
+void game_update(GameState *game, int ticks);
 
 /*
  * game_move_piece - Déplace la pièce courante
@@ -96,15 +221,16 @@ bool game_move_piece(GameState *game, int dx, int dy);
 /*
  * game_rotate_piece - Fait tourner la pièce courante
  *
- * Vérifie d'abord si la rotation est possible
- * Si la rotation cause une collision, essaie des ajustements (wall kick)
+ * Vérifie d'abord si la rotation est possible sur place
+ * Sinon, essaie les décalages SRS (wall kicks) dans l'ordre des tables
  *
  * Paramètres:
  *   game: L'état du jeu
+ *   direction: Sens de rotation (horaire, anti-horaire, demi-tour)
  *
  * Retour: true si la rotation a été effectuée, false sinon
  */
-bool game_rotate_piece(GameState *game);
+bool game_rotate_piece(GameState *game, RotationDirection direction);
 
 /*
  * game_drop_piece - Fait tomber la pièce instantanément (hard drop)
@@ -122,17 +248,17 @@ void game_drop_piece(GameState *game);
  *
  * Vérifie:
  * 1. Les limites de la grille (murs, fond)
- * 2. Les blocs déjà fixés
+ * 2. Les blocs déjà fixés (test d'un bit dans grid_rows)
  *
  * Paramètres:
+ *   game: L'état du jeu (grille d'occupation)
  *   piece: La pièce à vérifier
- *   fixed_blocks: Les blocs fixés dans la grille
  *   dx: Décalage horizontal à tester
  *   dy: Décalage vertical à tester
  *
  * Retour: true si collision, false sinon
  */
-bool game_check_collision(Piece *piece, BlockList *fixed_blocks, int dx, int dy);
+bool game_check_collision(GameState *game, Piece *piece, int dx, int dy);
 
 /*
  * game_fix_piece - Fixe la pièce courante dans la grille
@@ -149,8 +275,8 @@ void game_fix_piece(GameState *game);
  * game_check_lines - Vérifie et supprime les lignes complètes
  *
  * Pour chaque ligne:
- * 1. Compte le nombre de blocs
- * 2. Si 10 blocs (ligne pleine):
+ * 1. Compare son masque d'occupation à GRID_ROW_FULL
+ * 2. Si la ligne est pleine:
  *    - Supprime tous les blocs de cette ligne
  *    - Descend tous les blocs au-dessus
  *    - Augmente le score
@@ -187,12 +313,28 @@ void game_toggle_pause(GameState *game);
  * game_reset - Réinitialise le jeu
  *
  * Vide la grille, remet le score à 0, génère de nouvelles pièces
+ * (le tirage continue la suite de la graine: les parties successives
+ * restent reproductibles)
  *
  * Paramètres:
  *   game: L'état du jeu à réinitialiser
  */
 void game_reset(GameState *game);
 
+/*
+ * game_get_ghost_distance - Nombre de lignes dont la pièce peut tomber
+ *
+ * Calculée à partir des hauteurs de colonnes quand la pièce est
+ * au-dessus de la pile (sinon ligne par ligne), puis gardée en cache
+ * jusqu'au prochain déplacement latéral, rotation ou fixation.
+ *
+ * Paramètres:
+ *   game: L'état du jeu
+ *
+ * Retour: Distance de chute (0 si la pièce repose déjà)
+ */
+int game_get_ghost_distance(GameState *game);
+
 /*
  * game_get_ghost_y - Calcule la position Y d'une "pièce fantôme"
  *
@@ -201,8 +343,44 @@ void game_reset(GameState *game);
  * Paramètres:
  *   game: L'état du jeu
  *
- * Retour: Position Y de la pièce fantôme
+ * Retour: Position Y (bloc le plus haut) de la pièce fantôme
  */
 int game_get_ghost_y(GameState *game);
 
+/*
+ * game_set_event_hook - Installe le crochet d'événements
+ *
+ * Le crochet reste en place après game_reset.
+ *
+ * Paramètres:
+ *   game: L'état du jeu
+ *   hook: Fonction appelée à chaque événement (NULL pour retirer)
+ *   user: Pointeur transmis au crochet
+ */
+void game_set_event_hook(GameState *game, GameEventHook hook, void *user);
+
+/*
+ * game_take_dirty - Récupère et efface les cases modifiées de la grille
+ *
+ * Permet de savoir si la grille a changé sans la comparer (voir
+ * GameSnapshot.grid_version).
+ *
+ * Paramètres:
+ *   game: L'état du jeu
+ *   rows: Reçoit un masque de cases modifiées par ligne
+ */
+void game_take_dirty(GameState *game, GridRow rows[GRID_HEIGHT]);
+
+/*
+ * game_snapshot - Copie l'état affichable du jeu dans un instantané
+ *
+ * Calcule au passage la distance du fantôme (cache de game).
+ * grid_version et sequence ne sont pas modifiés.
+ *
+ * Paramètres:
+ *   game: L'état du jeu
+ *   snapshot: Instantané à remplir
+ */
+void game_snapshot(GameState *game, GameSnapshot *snapshot);
+
 #endif /* GAME_H */
\ No newline at end of file
@@ -6,32 +6,72 @@
 #define LIST_H
 
 #include <stdbool.h>
-#include <SDL2/SDL.h> //  Utiliser la vraie définition SDL2
+#include <stddef.h>
+#include "color.h"
 
 /*
  * Structure Block - Représente un bloc unique dans la grille
+ *
+ * y sert de clé à l'index par ligne de la liste: pour déplacer des blocs
+ * indexés verticalement, utiliser list_shift_rows_down plutôt que
+ * modifier y directement.
  */
 typedef struct Block
 {
-    int x;              // Position horizontale (0-9)
-    int y;              // Position verticale (0-19)
-    SDL_Color color;    // Couleur RGB du bloc
-    struct Block *next; // Pointeur vers le bloc suivant
+    int x;                  // Position horizontale (0-9)
+    int y;                  // Position verticale (0-19)
+    Color color;            // Couleur RGB du bloc
+    struct Block *next;     // Pointeur vers le bloc suivant
+    struct Block *prev;     // Pointeur vers le bloc précédent
+    struct Block *row_next; // Bloc suivant dans la même ligne (index)
 } Block;
 
+// Nombre de lignes couvertes par l'index (les autres y vont dans
+// un seau de débordement, parcouru linéairement)
+#define LIST_INDEX_ROWS 32
+
 /*
  * Structure BlockList - Liste chaînée de blocs
+ *
+ * Les blocs ne sont pas alloués un par un: ils proviennent d'un pool
+ * global de slabs (voir list_pool_reserve) et y retournent à la
+ * suppression. tail permet l'ajout et la libération en bloc en O(1).
+ *
+ * Chaque bloc est aussi rangé dans le seau de sa ligne (rows[y]), avec
+ * un compteur par ligne: recherche, suppression et vidage d'une ligne
+ * ne parcourent que les blocs de cette ligne.
  */
 typedef struct BlockList
 {
-    Block *head; // Premier élément de la liste
-    int count;   // Nombre d'éléments
+    Block *head;                         // Premier élément de la liste
+    Block *tail;                         // Dernier élément de la liste
+    int count;                           // Nombre d'éléments
+    Block *rows[LIST_INDEX_ROWS + 1];    // Seaux par ligne (+ débordement)
+    int row_counts[LIST_INDEX_ROWS + 1]; // Nombre de blocs par seau
 } BlockList;
 
+/*
+ * Structure ListAllocStats - Compteurs du pool de blocs
+ *
+ * slab_allocs ne doit plus augmenter une fois le jeu lancé:
+ * en régime permanent, les blocs sont recyclés via la freelist.
+ */
+typedef struct ListAllocStats
+{
+    size_t slab_allocs;  // Nombre de slabs alloués (appels à malloc)
+    size_t block_allocs; // Blocs pris dans le pool
+    size_t block_frees;  // Blocs rendus au pool
+    size_t blocks_live;  // Blocs actuellement utilisés par des listes
+    size_t blocks_free;  // Blocs disponibles dans la freelist
+} ListAllocStats;
+
+// Nombre de blocs par slab
+#define LIST_SLAB_SIZE 64
+
 // Toutes les autres fonctions restent identiques...
 BlockList *list_create(void);
 void list_destroy(BlockList *list);
-bool list_add(BlockList *list, int x, int y, SDL_Color color);
+bool list_add(BlockList *list, int x, int y, Color color);
 bool list_remove(BlockList *list, int x, int y);
 Block *list_find(BlockList *list, int x, int y);
 void list_clear(BlockList *list);
@@ -40,4 +80,48 @@ BlockList *list_copy(BlockList *list);
 void list_print(BlockList *list);
 int list_count(BlockList *list);
 
+/*
+ * list_row_count - Nombre de blocs sur la ligne y (O(1))
+ */
+int list_row_count(BlockList *list, int y);
+
+/*
+ * list_remove_row - Supprime tous les blocs de la ligne y
+ *
+ * Ne parcourt que le seau de la ligne.
+ *
+ * Retour: Nombre de blocs supprimés
+ */
+int list_remove_row(BlockList *list, int y);
+
+/*
+ * list_shift_rows_down - Descend d'un cran tous les blocs au-dessus de y
+ *
+ * Les seaux des lignes 0..y-1 glissent vers 1..y: la ligne y doit
+ * être vide (voir list_remove_row).
+ */
+void list_shift_rows_down(BlockList *list, int y);
+
+/*
+ * list_pool_reserve - Préalloue des blocs dans le pool
+ *
+ * Garantit qu'au moins count blocs sont disponibles sans nouvel
+ * appel à malloc.
+ *
+ * Retour: true si la réserve est disponible, false si échec
+ */
+bool list_pool_reserve(int count);
+
+/*
+ * list_pool_release - Libère tous les slabs du pool
+ *
+ * À appeler uniquement quand plus aucune liste n'existe.
+ */
+void list_pool_release(void);
+
+/*
+ * list_alloc_stats - Retourne les compteurs du pool de blocs
+ */
+ListAllocStats list_alloc_stats(void);
+
 #endif /* LIST_H */
\ No newline at end of file
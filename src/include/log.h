@@ -0,0 +1,124 @@
+/*
+ * log.h - Journal asynchrone de la console
+ *
+ * Les messages de la boucle (statistiques, pause, game over, rapports
+ * de cadencement et de profil) ne sont plus écrits par le thread qui
+ * les émet: log_write copie le format et les valeurs brutes des
+ * arguments dans un tampon circulaire, sans verrou ni allocation. Un
+ * thread d'écriture formate les messages et les écrit dans la console.
+ * Une console lente ne ralentit donc plus le jeu; si le tampon est
+ * plein, le message est perdu (et compté), jamais attendu.
+ *
+ * Le format est relu par le thread d'écriture: les chaînes passées en
+ * %s doivent rester valides (chaînes statiques). Formats acceptés:
+ * d i u x X o c (modificateurs h l ll z), f e g, s, p et %%.
+ *
+ * Journal fermé (avant log_open, après log_close), log_write écrit
+ * directement: l'ordre des messages reste celui des appels.
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Messages en attente au plus (puissance de deux)
+#define LOG_CAPACITY 1024
+
+// Arguments gardés par message (les suivants sont affichés "?")
+#define LOG_MAX_ARGS 6
+
+// Longueur maximale d'un message formaté (tronqué au-delà)
+#define LOG_LINE_MAX 512
+
+/*
+ * LogLevel - Sévérité d'un message
+ *
+ * LOG_WARN et LOG_ERROR vont sur stderr, les autres sur stdout.
+ */
+typedef enum
+{
+    LOG_DEBUG,
+    LOG_INFO,
+    LOG_WARN,
+    LOG_ERROR
+} LogLevel;
+
+/*
+ * LogValue - Valeur brute d'un argument (le type est donné par le format)
+ */
+typedef union
+{
+    long long i;
+    unsigned long long u;
+    double f;
+    const char *s;
+    const void *p;
+} LogValue;
+
+/*
+ * Structure LogRecord - Une case du tampon
+ *
+ * - sequence: Numéro de passage de la case (file bornée de Vyukov:
+ *   libre pour le ticket n si sequence == n, remplie si n + 1)
+ * - format: Format du message (chaîne statique)
+ * - count: Arguments gardés dans args
+ */
+typedef struct
+{
+    SDL_atomic_t sequence;
+    LogLevel level;
+    const char *format;
+    int count;
+    LogValue args[LOG_MAX_ARGS];
+} LogRecord;
+
+/*
+ * log_open - Lance le thread d'écriture
+ *
+ * Retour: true si le journal est asynchrone (sinon log_write continue
+ *         d'écrire directement)
+ */
+bool log_open(void);
+
+/*
+ * log_close - Écrit les messages en attente et arrête le thread
+ *
+ * À appeler quand plus aucun autre thread n'écrit (simulation arrêtée).
+ * Sans effet si le journal n'est pas ouvert.
+ */
+void log_close(void);
+
+/*
+ * log_set_level - Ignore les messages moins sévères que level
+ *
+ * Paramètres:
+ *   level: Sévérité minimale (LOG_DEBUG par défaut: tout est écrit)
+ */
+void log_set_level(LogLevel level);
+
+/*
+ * log_level_from_name - Lit une sévérité ("debug", "info", "warn",
+ * "error")
+ *
+ * Paramètres:
+ *   name: Le nom
+ *   level: Reçoit la sévérité
+ *
+ * Retour: true si le nom est connu
+ */
+bool log_level_from_name(const char *name, LogLevel *level);
+
+/*
+ * log_write - Ajoute un message au journal (format de printf)
+ *
+ * Ne bloque jamais: utilisable depuis n'importe quel thread.
+ *
+ * Paramètres:
+ *   level: Sévérité
+ *   format: Format (chaîne statique), suivi de ses arguments
+ */
+void log_write(LogLevel level, const char *format, ...);
+
+#endif /* LOG_H */
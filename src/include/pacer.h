@@ -0,0 +1,91 @@
+/*
+ * pacer.h - Cadencement des frames
+ *
+ * Remplace le SDL_Delay fixe de fin de frame: chaque frame a une
+ * échéance absolue (compteur haute résolution). On dort jusqu'un peu
+ * avant, puis on attend activement la fin, pour une cadence régulière
+ * quel que soit le temps passé à dessiner.
+ */
+
+#ifndef PACER_H
+#define PACER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// FPS cible par défaut
+#define PACER_DEFAULT_FPS 60
+
+// Marge d'attente active avant l'échéance (ms): SDL_Delay peut dormir
+// plus longtemps que demandé
+#define PACER_SPIN_MS 2
+
+// Intervalle entre deux rapports de frames en retard (s)
+#define PACER_REPORT_SECONDS 5
+
+/*
+ * Structure FramePacer - État du cadencement
+ *
+ * - period: Durée d'une frame en unités du compteur (0 = sans limite)
+ * - deadline: Échéance de la frame en cours
+ * - frames, missed: Frames cadencées et frames arrivées après leur
+ *   échéance (depuis le lancement)
+ * - window_*: Mêmes compteurs depuis le dernier rapport, et pire retard
+ */
+typedef struct
+{
+    Uint64 freq;
+    Uint64 period;
+    Uint64 spin;
+    Uint64 deadline;
+    Uint64 frames;
+    Uint64 missed;
+    Uint64 window_start;
+    Uint64 window_frames;
+    Uint64 window_missed;
+    Uint64 window_worst;
+} FramePacer;
+
+/*
+ * pacer_init - Prépare le cadencement
+ *
+ * Paramètres:
+ *   pacer: Le cadenceur
+ *   target_fps: Frames par seconde visées, 0 pour ne pas limiter (par
+ *               exemple quand la synchronisation verticale cadence déjà)
+ */
+void pacer_init(FramePacer *pacer, int target_fps);
+
+/*
+ * pacer_wait - Attend l'échéance de la frame puis fixe la suivante
+ *
+ * À appeler une fois par frame, après render_present. Une frame qui
+ * finit après son échéance compte comme manquée; si le retard dépasse
+ * une période, les échéances repartent de maintenant (pas de rafale
+ * de frames pour rattraper).
+ *
+ * Paramètres:
+ *   pacer: Le cadenceur
+ */
+void pacer_wait(FramePacer *pacer);
+
+/*
+ * pacer_resync - Repart de maintenant sans compter de frame manquée
+ *
+ * À appeler après une attente hors cadencement (veille en pause ou
+ * après un game over): la frame suivante a une période complète.
+ *
+ * Paramètres:
+ *   pacer: Le cadenceur
+ */
+void pacer_resync(FramePacer *pacer);
+
+/*
+ * pacer_report - Affiche le bilan des frames manquées
+ *
+ * Paramètres:
+ *   pacer: Le cadenceur
+ */
+void pacer_report(const FramePacer *pacer);
+
+#endif /* PACER_H */
@@ -0,0 +1,162 @@
+/*
+ * perf.h - Compteurs de performance pour l'affichage en jeu (F1)
+ *
+ * Collecte, pour chaque frame présentée: sa durée (FPS, historique,
+ * p99), la vitesse de la simulation (ticks par seconde), le nombre
+ * d'allocations et d'appels de dessin. La collecte se limite à quelques
+ * soustractions par frame; le tri pour le p99 n'est fait que si
+ * l'affichage est visible.
+ *
+ * Les allocations sont comptées à deux endroits: le crochet de
+ * alloc_malloc (cœur et front end) et les fonctions mémoire de SDL
+ * (SDL, SDL_ttf, pilotes de rendu), voir perf_count_allocations.
+ *
+ * Après la première frame, la boucle ne doit plus allouer (tampons
+ * créés à l'initialisation, voir render_prewarm): perf_seal_allocations
+ * compte à part, ou rend fatale, toute allocation ultérieure.
+ */
+
+#ifndef PERF_H
+#define PERF_H
+
+#include "game.h"
+#include <SDL2/SDL.h>
+
+// Frames gardées dans l'historique (une barre par frame)
+#define PERF_HISTORY 120
+
+// Intervalle de mesure des ticks par seconde (ms)
+#define PERF_TICK_WINDOW_MS 500
+
+/*
+ * PerfSeal - Sort des allocations (voir perf_seal_allocations)
+ *
+ * - PERF_SEAL_NONE: Permises (initialisation, fermeture)
+ * - PERF_SEAL_COUNT: Comptées à part (perf_late_allocations)
+ * - PERF_SEAL_ABORT: Aide au débogage: la première allocation du jeu
+ *   (alloc_malloc) arrête le programme (abort) pour qu'un débogueur
+ *   montre qui l'a faite. Celles internes à SDL (file d'événements qui
+ *   grandit, textures recréées après une perte du périphérique...) ne
+ *   dépendent pas du jeu: elles sont seulement comptées
+ */
+typedef enum
+{
+    PERF_SEAL_NONE,
+    PERF_SEAL_COUNT,
+    PERF_SEAL_ABORT
+} PerfSeal;
+
+/*
+ * Structure PerfStats - Compteurs de la dernière frame et historique
+ *
+ * - frame_ms, history_head, history_count: Durées des dernières frames
+ *   (tampon circulaire, history_head = prochaine case écrite)
+ * - last_frame: Date de la frame précédente (compteur haute résolution)
+ * - tick_mark, tick_mark_time: Tick de simulation et date du début de
+ *   la fenêtre de mesure
+ * - ticks_per_second: Vitesse mesurée sur la dernière fenêtre
+ * - alloc_mark: Allocations comptées à la frame précédente
+ * - frame_allocs, frame_draw_calls: Allocations et appels de dessin de
+ *   la dernière frame
+ */
+typedef struct
+{
+    Uint64 freq;
+    Uint64 last_frame;
+    float frame_ms[PERF_HISTORY];
+    int history_head;
+    int history_count;
+    uint64_t tick_mark;
+    Uint64 tick_mark_time;
+    float ticks_per_second;
+    int alloc_mark;
+    int frame_allocs;
+    int frame_draw_calls;
+} PerfStats;
+
+/*
+ * perf_count_allocations - Compte les allocations du jeu et de SDL
+ *
+ * Remplace les fonctions mémoire de SDL par des versions qui comptent,
+ * et installe le crochet de alloc_malloc. À appeler en tout premier,
+ * avant toute autre fonction SDL (render_init).
+ */
+void perf_count_allocations(void);
+
+/*
+ * perf_allocations - Allocations comptées depuis perf_count_allocations
+ *
+ * Retour: Nombre d'allocations (tous threads)
+ */
+int perf_allocations(void);
+
+/*
+ * perf_seal_allocations - Change le sort des allocations à venir
+ *
+ * La boucle scelle les allocations après la première frame et les
+ * libère avant la fermeture.
+ *
+ * Paramètres:
+ *   mode: Voir PerfSeal
+ */
+void perf_seal_allocations(PerfSeal mode);
+
+/*
+ * perf_late_allocations - Allocations depuis perf_seal_allocations
+ *
+ * Retour: Nombre d'allocations (tous threads)
+ */
+int perf_late_allocations(void);
+
+/*
+ * perf_init - Remet les compteurs à zéro
+ *
+ * Paramètres:
+ *   perf: Les compteurs
+ */
+void perf_init(PerfStats *perf);
+
+/*
+ * perf_frame - Enregistre une frame présentée
+ *
+ * À appeler après render_present.
+ *
+ * Paramètres:
+ *   perf: Les compteurs
+ *   game: Instantané affiché (tick de simulation)
+ *   draw_calls: Appels de dessin de la frame (Renderer.frame_draw_calls)
+ */
+void perf_frame(PerfStats *perf, const GameSnapshot *game, int draw_calls);
+
+/*
+ * perf_fps - FPS moyennes sur l'historique
+ *
+ * Paramètres:
+ *   perf: Les compteurs
+ *
+ * Retour: Frames par seconde (0 sans historique)
+ */
+float perf_fps(const PerfStats *perf);
+
+/*
+ * perf_p99_ms - Durée de frame sous laquelle tombent 99% de l'historique
+ *
+ * Paramètres:
+ *   perf: Les compteurs
+ *
+ * Retour: Durée en millisecondes (0 sans historique)
+ */
+float perf_p99_ms(const PerfStats *perf);
+
+/*
+ * perf_history - Durée d'une frame de l'historique
+ *
+ * Paramètres:
+ *   perf: Les compteurs
+ *   age: 0 pour la plus ancienne, history_count - 1 pour la dernière
+ *
+ * Retour: Durée en millisecondes
+ */
+float perf_history(const PerfStats *perf, int age);
+
+#endif /* PERF_H */
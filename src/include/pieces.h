@@ -8,7 +8,9 @@
 #define PIECES_H
 
 #include "list.h"
+#include "rng.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /*
  * Énumération des types de pièces Tetris
@@ -40,53 +42,134 @@ typedef enum
     PIECE_COUNT // Nombre total de types (utilisé pour random)
 } PieceType;
 
+// Nombre de blocs dans une pièce
+#define PIECE_BLOCKS 4
+
+// Nombre maximal de positions testées lors d'une rotation (wall kicks)
+#define KICK_MAX_TESTS 6
+
+/*
+ * Énumération des sens de rotation
+ *
+ * La valeur est le nombre de quarts de tour dans le sens horaire.
+ */
+typedef enum
+{
+    ROTATE_CW = 1,  // Sens horaire
+    ROTATE_180 = 2, // Demi-tour
+    ROTATE_CCW = 3  // Sens anti-horaire
+} RotationDirection;
+
+/*
+ * Structure PieceCell - Position d'un bloc relative à l'origine de la pièce
+ */
+typedef struct
+{
+    int x; // Décalage horizontal
+    int y; // Décalage vertical
+} PieceCell;
+
 /*
  * Structure Piece - Représente une pièce Tetris
  *
  * Contient:
- * - blocks: Liste chaînée des 4 blocs qui composent la pièce
+ * - cells: Les 4 blocs de la pièce, relatifs à l'origine (x, y)
+ * - x, y: Origine de la pièce (coin haut-gauche de sa boîte de rotation)
  * - type: Type de la pièce (I, O, T, etc.)
  * - rotation: Rotation actuelle (0, 1, 2, 3 pour 0°, 90°, 180°, 270°)
+ * - color: Couleur des blocs
+ *
+ * Tout est stocké en ligne: une pièce se copie par simple affectation
+ * et ne demande aucune allocation.
+ * Position du bloc i dans la grille: (x + cells[i].x, y + cells[i].y)
  */
 typedef struct
 {
-    BlockList *blocks; // Liste des 4 blocs
-    PieceType type;    // Type de pièce
-    int rotation;      // État de rotation (0-3)
+    PieceCell cells[PIECE_BLOCKS]; // Blocs relatifs à l'origine
+    int x;                         // Origine (colonne)
+    int y;                         // Origine (ligne)
+    PieceType type;                // Type de pièce
+    int rotation;                  // État de rotation (0-3)
+    Color color;                   // Couleur des blocs
 } Piece;
 
 /*
- * piece_create - Crée une nouvelle pièce aléatoire
+ * Structure PieceBag - Générateur de pièces "7-bag"
  *
- * La pièce est créée en haut de la grille (x=4, y=0)
- * avec une orientation par défaut
+ * Les 7 types sont tirés dans un sac mélangé, vidé avant d'en mélanger
+ * un nouveau: chaque type revient au plus tard après 12 pièces, et
+ * jamais plus de deux fois de suite.
+ *
+ * - rng: Générateur du mélange
+ * - order: Sac mélangé (types restants dans order[0..remaining-1])
+ * - remaining: Pièces restantes dans le sac
+ *
+ * Tout est stocké en ligne: copier le sac duplique la suite à venir.
+ */
+typedef struct
+{
+    Rng rng;
+    uint8_t order[PIECE_COUNT];
+    int remaining;
+} PieceBag;
+
+/*
+ * piece_bag_init - Prépare un sac vide
  *
  * Paramètres:
- *   type: Type de pièce à créer
+ *   bag: Le sac
+ *   seed: Graine du mélange (même graine = même suite de pièces)
+ */
+void piece_bag_init(PieceBag *bag, uint64_t seed);
+
+/*
+ * piece_bag_reset - Vide le sac sans toucher au générateur
  *
- * Retour: Pointeur vers la nouvelle pièce, ou NULL si échec
+ * Le prochain tirage mélange un sac complet; la suite reste celle de
+ * la graine.
+ *
+ * Paramètres:
+ *   bag: Le sac
  */
-Piece *piece_create(PieceType type);
+void piece_bag_reset(PieceBag *bag);
 
 /*
- * piece_create_random - Crée une pièce de type aléatoire
+ * piece_bag_next - Tire le prochain type du sac
+ *
+ * Mélange un nouveau sac (Fisher-Yates) quand le précédent est vide.
  *
- * Retour: Pointeur vers la nouvelle pièce
+ * Paramètres:
+ *   bag: Le sac
+ *
+ * Retour: Type de la prochaine pièce (PIECE_I si bag est NULL)
  */
-Piece *piece_create_random(void);
+PieceType piece_bag_next(PieceBag *bag);
 
 /*
- * piece_destroy - Détruit une pièce et libère sa mémoire
+ * piece_init - Initialise une pièce selon son type
+ *
+ * La pièce est placée en haut de la grille (boîte de rotation
+ * à partir de la colonne 3) dans son orientation de départ
  *
  * Paramètres:
- *   piece: La pièce à détruire
+ *   piece: La pièce à initialiser
+ *   type: Type de pièce à créer
  */
-void piece_destroy(Piece *piece);
+void piece_init(Piece *piece, PieceType type);
+
+/*
+ * piece_init_random - Initialise une pièce du type tiré dans un sac
+ *
+ * Paramètres:
+ *   piece: La pièce à initialiser
+ *   bag: Le sac de la partie
+ */
+void piece_init_random(Piece *piece, PieceBag *bag);
 
 /*
  * piece_move - Déplace une pièce
  *
- * Ajoute dx et dy à la position de chaque bloc
+ * Ajoute dx et dy à l'origine de la pièce
  *
  * Paramètres:
  *   piece: La pièce à déplacer
@@ -96,51 +179,56 @@ void piece_destroy(Piece *piece);
 void piece_move(Piece *piece, int dx, int dy);
 
 /*
- * piece_rotate - Fait tourner la pièce de 90° dans le sens horaire
+ * piece_rotate - Fait tourner la pièce sur place
  *
- * Utilise la formule de rotation:
- *   new_x = center_x - (old_y - center_y)
- *   new_y = center_y + (old_x - center_x)
+ * Les blocs du nouvel état sont lus dans une table constante
+ * (orientations SRS): aucun calcul flottant, le pivot ne dérive pas.
+ * Aucun wall kick n'est appliqué ici (voir game_rotate_piece).
  *
- * Note: La pièce O (carré) ne tourne pas
+ * Note: La pièce O (carré) garde la même forme
  *
  * Paramètres:
  *   piece: La pièce à faire tourner
+ *   direction: Sens de rotation
  */
-void piece_rotate(Piece *piece);
+void piece_rotate(Piece *piece, RotationDirection direction);
 
 /*
- * piece_get_color - Retourne la couleur associée à un type de pièce
+ * piece_get_shape - Retourne les blocs d'un type dans un état de rotation
  *
  * Paramètres:
  *   type: Type de la pièce
+ *   rotation: État de rotation (0-3)
  *
- * Retour: Couleur SDL_Color
+ * Retour: Tableau constant de PIECE_BLOCKS positions relatives
  */
-SDL_Color piece_get_color(PieceType type);
+const PieceCell *piece_get_shape(PieceType type, int rotation);
 
 /*
- * piece_get_center - Calcule le centre de rotation d'une pièce
+ * piece_get_kicks - Retourne les décalages de wall kick SRS
  *
- * Le centre est calculé comme la moyenne des positions des blocs
+ * Les décalages sont à essayer dans l'ordre; le premier est toujours
+ * (0, 0). I a sa propre table, O ne se décale jamais.
  *
  * Paramètres:
- *   piece: La pièce
- *   center_x: Pointeur pour stocker la coordonnée X du centre
- *   center_y: Pointeur pour stocker la coordonnée Y du centre
+ *   type: Type de la pièce
+ *   from: État de rotation de départ (0-3)
+ *   direction: Sens de rotation
+ *   count: Pointeur pour stocker le nombre de décalages
+ *
+ * Retour: Tableau constant de décalages (y vers le bas)
  */
-void piece_get_center(Piece *piece, float *center_x, float *center_y);
+const PieceCell *piece_get_kicks(PieceType type, int from,
+                                 RotationDirection direction, int *count);
 
 /*
- * piece_copy - Crée une copie d'une pièce
- *
- * Utile pour tester une rotation avant de la valider
+ * piece_get_color - Retourne la couleur associée à un type de pièce
  *
  * Paramètres:
- *   piece: La pièce à copier
+ *   type: Type de la pièce
  *
- * Retour: Nouvelle pièce copiée
+ * Retour: Couleur de la palette du jeu
  */
-Piece *piece_copy(Piece *piece);
+Color piece_get_color(PieceType type);
 
 #endif /* PIECES_H */
\ No newline at end of file
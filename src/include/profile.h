@@ -0,0 +1,116 @@
+/*
+ * profile.h - Profilage des phases de la boucle principale
+ *
+ * Chaque phase (événements, gravité, chaque appel render_*, présentation)
+ * est chronométrée au compteur haute résolution. Les durées vont dans
+ * un histogramme à précision relative constante (style HDR): quelques
+ * centaines de compteurs par phase, p50/p99/max sans garder les mesures.
+ *
+ * Compilé seulement avec TETRIS_PROFILE (make PROFILE=1). Sinon les
+ * macros PROFILE_* ne génèrent aucun code et seul profile_phase_name
+ * reste (utilisé par la trace).
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <SDL2/SDL.h>
+
+/*
+ * ProfilePhase - Phases chronométrées
+ *
+ * PROFILE_UPDATE est mesurée sur le thread de simulation (game_update),
+ * les autres sur le thread SDL. PROFILE_FRAME couvre une frame entière,
+ * attente de cadencement exclue.
+ */
+typedef enum
+{
+    PROFILE_EVENTS,
+    PROFILE_UPDATE,
+    PROFILE_BACKGROUND,
+    PROFILE_BOARD,
+    PROFILE_UI,
+    PROFILE_OVERLAY,
+    PROFILE_PRESENT,
+    PROFILE_FRAME,
+    PROFILE_PHASE_COUNT
+} ProfilePhase;
+
+/*
+ * profile_phase_name - Nom court d'une phase
+ *
+ * Paramètres:
+ *   phase: La phase
+ *
+ * Retour: Nom (chaîne statique)
+ */
+const char *profile_phase_name(ProfilePhase phase);
+
+#ifdef TETRIS_PROFILE
+
+// Précision des histogrammes: 2^PROFILE_SUB_BITS compteurs par
+// puissance de deux (erreur relative < 1/16)
+#define PROFILE_SUB_BITS 4
+#define PROFILE_SUB_COUNT (1 << PROFILE_SUB_BITS)
+
+// Durée maximale mesurée (µs): au-delà, la mesure est plafonnée
+#define PROFILE_MAX_BITS 26
+#define PROFILE_MAX_US ((1 << PROFILE_MAX_BITS) - 1)
+
+// Nombre de compteurs: valeurs exactes sous PROFILE_SUB_COUNT, puis
+// PROFILE_SUB_COUNT compteurs par puissance de deux
+#define PROFILE_BUCKETS \
+    (PROFILE_SUB_COUNT * (PROFILE_MAX_BITS - PROFILE_SUB_BITS + 1))
+
+/*
+ * Structure ProfileHistogram - Durées d'une phase (µs)
+ *
+ * Un seul thread écrit dans un histogramme, mais profile_dump peut le
+ * lire depuis un autre: compteurs atomiques.
+ *
+ * - start: Début de la mesure en cours (thread écrivain uniquement)
+ * - max: Plus longue mesure
+ * - buckets: Nombre de mesures par tranche
+ */
+typedef struct
+{
+    Uint64 start;
+    SDL_atomic_t max;
+    SDL_atomic_t buckets[PROFILE_BUCKETS];
+} ProfileHistogram;
+
+/*
+ * profile_begin - Démarre la mesure d'une phase
+ *
+ * Paramètres:
+ *   phase: La phase
+ */
+void profile_begin(ProfilePhase phase);
+
+/*
+ * profile_end - Termine la mesure d'une phase et l'ajoute à son
+ * histogramme
+ *
+ * Paramètres:
+ *   phase: La phase (même thread que profile_begin)
+ */
+void profile_end(ProfilePhase phase);
+
+/*
+ * profile_dump - Affiche nombre, p50, p99 et max de chaque phase
+ */
+void profile_dump(void);
+
+#define PROFILE_BEGIN(phase) profile_begin(phase)
+#define PROFILE_END(phase) profile_end(phase)
+#define PROFILE_DUMP() profile_dump()
+
+#else
+
+#define PROFILE_BEGIN(phase) ((void)0)
+#define PROFILE_END(phase) ((void)0)
+#define PROFILE_DUMP() ((void)0)
+
+#endif /* TETRIS_PROFILE */
+
+#endif /* PROFILE_H */
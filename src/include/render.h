@@ -6,6 +6,8 @@
 #define RENDER_H
 
 #include "game.h"
+#include "perf.h"
+#include "text.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
@@ -16,8 +18,83 @@
 #define GRID_OFFSET_X 250
 #define GRID_OFFSET_Y 50
 
+// Taille d'un sprite de bloc (la case moins ses bords de grille)
+#define SPRITE_SIZE (BLOCK_SIZE - 2)
+
+// Capacité du lot de rectangles (quads) envoyé en un seul appel
+#define RENDER_BATCH_QUADS 1024
+
+// Affichage des performances (F1): position, taille et hauteur des
+// barres de durée de frame (HUD_BAR_MS remplit la hauteur)
+#define HUD_X 10
+#define HUD_Y 400
+#define HUD_WIDTH 230
+#define HUD_HEIGHT 190
+#define HUD_BAR_HEIGHT 60
+#define HUD_BAR_MS 50.0f
+
+// Événements mis en réserve dans la file de SDL par render_prewarm
+// (une rafale d'entrées jusqu'à ce nombre ne fait pas grandir la file)
+#define RENDER_PREWARM_EVENTS 256
+
+/*
+ * Structure OverlayCell - Case occupée par la pièce courante ou son
+ * fantôme, telle que peinte dans la texture de la grille
+ */
+typedef struct
+{
+    int x, y;
+    bool ghost; // true = fantôme, false = pièce
+} OverlayCell;
+
+/*
+ * BoardMode - Façon de dessiner le contenu de la grille
+ *
+ * - BOARD_MODE_TARGET: texture cible à la taille de la grille, seules les
+ *   cases modifiées y sont repeintes (mode par défaut)
+ * - BOARD_MODE_STREAMING: texture de streaming d'un texel par case,
+ *   agrandie en une copie, puis surimpression du relief et de la grille;
+ *   coût indépendant du nombre de cases (grandes grilles, spectateurs)
+ */
+typedef enum
+{
+    BOARD_MODE_TARGET,
+    BOARD_MODE_STREAMING
+} BoardMode;
+
 /*
  * Structure Renderer - Contient les ressources SDL
+ *
+ * Les blocs ne sont pas dessinés un par un: render_block et les
+ * fonctions voisines ajoutent des quads colorés au lot (batch_*),
+ * envoyé en un seul SDL_RenderGeometry par render_flush.
+ *
+ * Ces quads sont texturés par l'atlas sprites: un bloc en relief par
+ * couleur de pièce et sa variante fantôme, construits au démarrage, plus
+ * un texel blanc échantillonné par les rectangles unis. Blocs et
+ * rectangles partagent donc la même texture et le même appel.
+ *
+ * Le décor fixe (fond, grille, bordure, cadres de l'UI) est dessiné une
+ * fois dans la texture cible background, puis recopié en un seul
+ * SDL_RenderCopy par frame. background_dirty force sa reconstruction
+ * (taille de la fenêtre changée, cibles de rendu perdues).
+ *
+ * Le rendu ne lit que des instantanés (GameSnapshot), jamais le
+ * GameState possédé par le thread de simulation.
+ *
+ * Le contenu de la grille (blocs fixés, pièce, fantôme) est gardé dans la
+ * texture cible board: seules les cases marquées dans board_dirty sont
+ * repeintes avant la recopie (voir render_board). En mode streaming,
+ * board_overlay_dirty force à repeindre la surimpression dans sa
+ * texture existante (cibles de rendu perdues).
+ *
+ * Le texte passe par text (atlas de glyphes et cache de chaînes, voir
+ * text.h): aucune rastérisation en régime permanent.
+ *
+ * draw_calls compte les appels de dessin SDL depuis le dernier
+ * render_present, qui en reporte le total (texte compris) dans
+ * frame_draw_calls. Si show_hud est vrai, render_ui affiche les
+ * compteurs de perf (voir perf.h).
  */
 typedef struct
 {
@@ -25,7 +102,34 @@ typedef struct
     SDL_Renderer *renderer;
     TTF_Font *font;
     TTF_Font *font_large;
+    TTF_Font *font_small;                              // Affichage des perfs
     bool running;
+    SDL_Vertex batch_vertices[RENDER_BATCH_QUADS * 4]; // 4 sommets par quad
+    int batch_indices[RENDER_BATCH_QUADS * 6];         // 2 triangles par quad
+    int batch_quads;                                   // Quads en attente
+    SDL_Texture *sprites;                              // Atlas des blocs
+    Color sprite_colors[PIECE_COUNT];                  // Couleur -> sprite
+    SDL_FPoint white_uv;                               // Texel blanc (pixels)
+    float sprites_inv_w, sprites_inv_h;                // 1 / taille de l'atlas
+    SDL_Texture *background;                           // Décor pré-rendu
+    bool background_dirty;                             // À redessiner?
+    TextCache text;                                    // Glyphes et chaînes
+    BoardMode board_mode;                              // Voir BoardMode
+    SDL_Texture *board;                                // Grille pré-rendue
+    SDL_Texture *board_texels;                         // Un texel par case
+    SDL_Texture *board_overlay;                        // Relief + grille
+    bool board_overlay_dirty;                          // À repeindre?
+    Uint32 board_pixels[GRID_HEIGHT][GRID_WIDTH];      // Copie des texels
+    GridRow board_dirty[GRID_HEIGHT];                  // Cases à repeindre
+    OverlayCell overlay[PIECE_BLOCKS * 2];             // Pièce + fantôme peints
+    int overlay_count;
+    GridRow board_rows[GRID_HEIGHT];                   // Grille peinte (copie)
+    Color board_colors[GRID_HEIGHT][GRID_WIDTH];
+    uint32_t board_version;                            // Sa grid_version
+    int draw_calls;                                    // Depuis render_present
+    int frame_draw_calls;                              // Dernière frame
+    bool show_hud;                                     // Perfs affichées?
+    const PerfStats *perf;                             // Perfs (NULL: aucune)
 } Renderer;
 
 /*
@@ -38,55 +142,129 @@ Renderer *render_init(void);
  */
 void render_destroy(Renderer *renderer);
 
+/*
+ * render_set_vsync - Active/désactive la synchronisation verticale
+ *
+ * Paramètres:
+ *   renderer: Le renderer
+ *   enabled: true pour attendre le rafraîchissement dans render_present
+ *
+ * Retour: false si le pilote ne le permet pas
+ */
+bool render_set_vsync(Renderer *renderer, bool enabled);
+
 /*
  * render_clear - Efface l'écran
  */
 void render_clear(Renderer *renderer);
 
+/*
+ * render_flush - Envoie les blocs en attente en un seul appel de dessin
+ *
+ * À appeler avant de dessiner quelque chose qui doit passer par-dessus
+ * les blocs (fait automatiquement par les overlays et render_present).
+ */
+void render_flush(Renderer *renderer);
+
 /*
  * render_present - Affiche le rendu à l'écran
  */
 void render_present(Renderer *renderer);
 
+/*
+ * render_background - Dessine le décor fixe (remplace render_clear)
+ *
+ * Recopie la texture du décor en un seul appel; la reconstruit d'abord
+ * si elle est marquée sale. Si les textures cibles ne sont pas
+ * disponibles, le décor est dessiné directement comme avant.
+ */
+void render_background(Renderer *renderer);
+
+/*
+ * render_handle_event - Suit les événements qui invalident le décor
+ *
+ * Redimensionnement de la fenêtre, perte des cibles de rendu ou du
+ * périphérique: le décor sera redessiné à la prochaine frame.
+ *
+ * Paramètres:
+ *   renderer: Le renderer
+ *   event: L'événement SDL reçu
+ */
+void render_handle_event(Renderer *renderer, const SDL_Event *event);
+
 /*
  * render_grid - Dessine la grille de jeu
  */
 void render_grid(Renderer *renderer);
 
 /*
- * render_block - Dessine un bloc individuel
+ * render_block - Dessine un bloc individuel (couleur de la palette du jeu)
+ *
+ * Le bloc est ajouté au lot courant (voir render_flush)
+ */
+void render_block(Renderer *renderer, int x, int y, Color color);
+
+/*
+ * render_board - Dessine le contenu de la grille (blocs fixés, fantôme,
+ * pièce courante)
+ *
+ * Ne repeint dans la texture de la grille que les cases modifiées: celles
+ * qui diffèrent de la dernière grille peinte (comparée seulement si
+ * grid_version a changé) et celles que la pièce ou son fantôme quittent
+ * ou occupent. La texture est ensuite recopiée en un
+ * seul appel (voir BoardMode). Sans textures cibles, tout est redessiné
+ * comme avant.
+ *
+ * Paramètres:
+ *   renderer: Le renderer
+ *   game: Instantané du jeu à afficher
  */
-void render_block(Renderer *renderer, int x, int y, SDL_Color color);
+void render_board(Renderer *renderer, const GameSnapshot *game);
+
+/*
+ * render_set_board_mode - Choisit la façon de dessiner la grille
+ *
+ * Toute la grille est redessinée à la frame suivante. Si le mode
+ * streaming n'est pas disponible, le mode texture cible est utilisé.
+ *
+ * Paramètres:
+ *   renderer: Le renderer
+ *   mode: BOARD_MODE_TARGET ou BOARD_MODE_STREAMING
+ */
+void render_set_board_mode(Renderer *renderer, BoardMode mode);
 
 /*
  * render_piece - Dessine une pièce Tetris
  */
-void render_piece(Renderer *renderer, Piece *piece);
+void render_piece(Renderer *renderer, const Piece *piece);
 
 /*
  * render_fixed_blocks - Dessine tous les blocs fixés
  */
-void render_fixed_blocks(Renderer *renderer, BlockList *blocks);
+void render_fixed_blocks(Renderer *renderer, const GameSnapshot *game);
 
 /*
  * render_ghost_piece - Dessine la pièce fantôme
  */
-void render_ghost_piece(Renderer *renderer, GameState *game);
+void render_ghost_piece(Renderer *renderer, const GameSnapshot *game);
 
 /*
- * render_next_piece - Dessine la prochaine pièce
+ * render_next_piece - Dessine la prochaine pièce (le cadre fait partie
+ * du décor)
  */
-void render_next_piece(Renderer *renderer, Piece *piece);
+void render_next_piece(Renderer *renderer, const Piece *piece);
 
 /*
- * render_ui - Dessine l'interface utilisateur
+ * render_ui - Dessine les parties variables de l'interface utilisateur
+ *
+ * Y compris l'affichage des performances quand show_hud est vrai.
  */
-void render_ui(Renderer *renderer, GameState *game);
+void render_ui(Renderer *renderer, const GameSnapshot *game);
 
 /*
  * render_game_over - Affiche l'écran de game over
  */
-void render_game_over(Renderer *renderer, GameState *game);
+void render_game_over(Renderer *renderer, const GameSnapshot *game);
 
 /*
  * render_pause - Affiche le message de pause
@@ -94,9 +272,34 @@ void render_game_over(Renderer *renderer, GameState *game);
 void render_pause(Renderer *renderer);
 
 /*
- * render_text - Dessine du texte avec SDL_ttf
+ * render_prewarm - Crée d'avance les ressources des écrans occasionnels
+ *
+ * Atlas de glyphes et libellés du game over et de l'affichage des
+ * perfs, sinon créés à leur premier affichage, et cases de la file
+ * d'événements de SDL (RENDER_PREWARM_EVENTS): après cet appel et la
+ * première frame, le rendu n'alloue plus en jeu normal. Restent les
+ * chemins internes de SDL qu'on ne peut pas anticiper (recréation
+ * des textures après une perte du périphérique de rendu...). À
+ * appeler avant la boucle et avant de lancer la simulation.
+ *
+ * Paramètres:
+ *   renderer: Le renderer
+ */
+void render_prewarm(Renderer *renderer);
+
+/*
+ * render_text - Dessine un libellé avec SDL_ttf (cache de chaînes)
  */
 void render_text(Renderer *renderer, const char *text, int x, int y,
                  SDL_Color color, TTF_Font *font);
 
+/*
+ * render_text_glyphs - Dessine un texte variable depuis l'atlas de glyphes
+ *
+ * Pour les valeurs qui changent (score, compteurs): ne remplit pas le
+ * cache de chaînes. Repli sur render_text si l'atlas est indisponible.
+ */
+void render_text_glyphs(Renderer *renderer, const char *text, int x, int y,
+                        SDL_Color color, TTF_Font *font);
+
 #endif /* RENDER_H */
\ No newline at end of file
@@ -0,0 +1,61 @@
+/*
+ * rng.h - Générateur pseudo-aléatoire du cœur (xoshiro256**)
+ *
+ * Remplace rand(): pas d'état global caché, une graine explicite, et
+ * un état de 32 octets qui se copie par simple affectation (une
+ * recherche ou une simulation en lot peut dupliquer la suite d'une
+ * partie). Même graine = même suite, sur toutes les machines.
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/*
+ * Structure Rng - État du générateur
+ *
+ * Jamais entièrement nul (rng_seed s'en charge).
+ */
+typedef struct
+{
+    uint64_t s[4];
+} Rng;
+
+/*
+ * rng_seed - Initialise le générateur
+ *
+ * L'état est dérivé de la graine par splitmix64: des graines proches
+ * (0, 1, 2...) donnent des suites indépendantes.
+ *
+ * Paramètres:
+ *   rng: Le générateur
+ *   seed: La graine (toute valeur, 0 compris)
+ */
+void rng_seed(Rng *rng, uint64_t seed);
+
+/*
+ * rng_next - Tire 64 bits
+ *
+ * Paramètres:
+ *   rng: Le générateur
+ *
+ * Retour: Valeur uniforme sur 64 bits
+ */
+uint64_t rng_next(Rng *rng);
+
+/*
+ * rng_below - Tire un entier uniforme dans [0, bound)
+ *
+ * Multiplication et rejet (méthode de Lemire): pas de biais de modulo,
+ * une division seulement dans le cas rare d'un rejet possible.
+ *
+ * Paramètres:
+ *   rng: Le générateur
+ *   bound: Borne exclue (> 0)
+ *
+ * Retour: L'entier tiré
+ */
+uint32_t rng_below(Rng *rng, uint32_t bound);
+
+#endif /* RNG_H */
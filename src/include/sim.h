@@ -0,0 +1,139 @@
+/*
+ * sim.h - Simulation du jeu sur son propre thread
+ *
+ * Le thread de simulation possède le GameState: il applique les
+ * commandes du joueur dès leur arrivée, avance l'horloge de ticks et
+ * publie un instantané (GameSnapshot) après chaque changement.
+ *
+ * Le thread SDL (événements, rendu) ne touche jamais au GameState:
+ * - il envoie les commandes par une file sans verrou (un producteur,
+ *   un consommateur)
+ * - il lit le dernier instantané publié par un triple tampon sans
+ *   verrou: le producteur écrit toujours dans un tampon que le lecteur
+ *   n'utilise pas, le lecteur garde le sien tant qu'il n'en prend pas
+ *   un plus récent
+ *
+ * Un rendu lent ne retarde donc ni les entrées ni la gravité.
+ *
+ * En pause ou après un game over, le thread de simulation dort jusqu'à
+ * la prochaine commande. Chaque entrée ou sortie de cet état est
+ * signalée au thread SDL par un événement (event_type), pour qu'il
+ * puisse lui aussi dormir dans SDL_WaitEventTimeout.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include "game.h"
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Capacité de la file de commandes (une case reste vide)
+#define SIM_QUEUE_SIZE 64
+
+// Retard maximal rattrapé d'un coup (en ticks): au-delà (machine en
+// veille...), le temps perdu est abandonné
+#define SIM_MAX_CATCHUP_TICKS (SIM_TICK_RATE / 4)
+
+// Triple tampon: index du dernier instantané + drapeau "pas encore lu"
+#define SIM_SNAPSHOT_INDEX 3
+#define SIM_SNAPSHOT_FRESH 4
+
+/*
+ * SimCommand - Actions du joueur transmises au thread de simulation
+ */
+typedef enum
+{
+    SIM_CMD_LEFT,
+    SIM_CMD_RIGHT,
+    SIM_CMD_SOFT_DROP,
+    SIM_CMD_ROTATE_CW,
+    SIM_CMD_ROTATE_CCW,
+    SIM_CMD_ROTATE_180,
+    SIM_CMD_HARD_DROP,
+    SIM_CMD_PAUSE,
+    SIM_CMD_RESET
+} SimCommand;
+
+/*
+ * Structure Simulation - Thread de simulation et ses échanges
+ *
+ * - game: Appartient au thread de simulation tant qu'il tourne
+ * - commands, cmd_head, cmd_tail: File circulaire de commandes (écrite
+ *   par le thread SDL en tête, lue par la simulation en queue)
+ * - wake: Réveille la simulation dès qu'une commande arrive
+ * - buffers, latest, back, front: Triple tampon d'instantanés. back est
+ *   le tampon du producteur, front celui du lecteur, latest le dernier
+ *   publié (échangés atomiquement)
+ * - grid_version: Incrémentée quand la grille change (game_take_dirty)
+ * - sequence: Numéro du dernier instantané publié
+ * - event_type: Événement SDL envoyé quand la partie entre en veille ou
+ *   en sort (0 si aucun n'a pu être réservé)
+ * - idle: Veille (pause ou game over) dans le dernier instantané publié
+ */
+typedef struct
+{
+    GameState *game;
+    SDL_Thread *thread;
+    SDL_atomic_t running;
+    SDL_sem *wake;
+    Uint8 commands[SIM_QUEUE_SIZE];
+    SDL_atomic_t cmd_head;
+    SDL_atomic_t cmd_tail;
+    GameSnapshot buffers[3];
+    SDL_atomic_t latest;
+    int back;
+    int front;
+    uint32_t grid_version;
+    uint32_t sequence;
+    Uint32 event_type;
+    bool idle;
+} Simulation;
+
+/*
+ * sim_start - Lance le thread de simulation
+ *
+ * Paramètres:
+ *   game: L'état du jeu, confié au thread jusqu'à sim_stop
+ *
+ * Retour: La simulation, NULL en cas d'erreur
+ */
+Simulation *sim_start(GameState *game);
+
+/*
+ * sim_stop - Arrête le thread et libère la simulation
+ *
+ * Le GameState redevient utilisable par l'appelant.
+ *
+ * Paramètres:
+ *   sim: La simulation
+ */
+void sim_stop(Simulation *sim);
+
+/*
+ * sim_push - Envoie une commande au thread de simulation
+ *
+ * À appeler depuis un seul thread (le thread SDL).
+ *
+ * Paramètres:
+ *   sim: La simulation
+ *   command: La commande
+ *
+ * Retour: false si la file est pleine (commande perdue)
+ */
+bool sim_push(Simulation *sim, SimCommand command);
+
+/*
+ * sim_latest - Dernier instantané publié
+ *
+ * L'instantané reste valide et inchangé jusqu'au prochain appel.
+ * À appeler depuis un seul thread (le thread SDL).
+ *
+ * Paramètres:
+ *   sim: La simulation
+ *
+ * Retour: Instantané le plus récent
+ */
+const GameSnapshot *sim_latest(Simulation *sim);
+
+#endif /* SIM_H */
@@ -0,0 +1,135 @@
+/*
+ * text.h - Cache de texte pour SDL_ttf
+ *
+ * Deux mécanismes, pour que l'affichage du texte en régime permanent ne
+ * crée ni surface ni texture et ne rastérise aucun glyphe:
+ * - Un atlas de glyphes par police (ASCII imprimable), rastérisé une
+ *   seule fois; une chaîne est dessinée en un SDL_RenderGeometry
+ * - Un cache LRU de textures de chaînes, indexé par (police, texte,
+ *   couleur), pour les libellés stables rendus tels quels par SDL_ttf
+ */
+
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Glyphes de l'atlas: ASCII imprimable (' ' à '~')
+#define TEXT_GLYPH_FIRST 32
+#define TEXT_GLYPH_LAST 126
+#define TEXT_GLYPH_COUNT (TEXT_GLYPH_LAST - TEXT_GLYPH_FIRST + 1)
+
+// Nombre maximal de polices avec un atlas
+#define TEXT_MAX_FONTS 4
+
+// Nombre d'entrées du cache de chaînes et longueur maximale d'une clé
+// (les chaînes plus longues sont rendues sans cache)
+#define TEXT_CACHE_SLOTS 32
+#define TEXT_CACHE_MAX_LEN 64
+
+// Glyphes dessinés au plus en un appel par text_draw_glyphs
+#define TEXT_MAX_GLYPHS 128
+
+/*
+ * Structure GlyphAtlas - Tous les glyphes d'une police dans une texture
+ *
+ * Les glyphes sont rastérisés en blanc: la couleur du texte est celle
+ * des sommets (modulation), donc un seul atlas sert pour toutes les
+ * couleurs.
+ */
+typedef struct
+{
+    TTF_Font *font;                      // Police (NULL = atlas libre)
+    SDL_Texture *texture;                // Glyphes côte à côte
+    int width, height;                   // Taille de la texture
+    SDL_Rect glyphs[TEXT_GLYPH_COUNT];   // Position de chaque glyphe
+    int advances[TEXT_GLYPH_COUNT];      // Avance horizontale
+} GlyphAtlas;
+
+/*
+ * Structure TextCacheEntry - Texture d'une chaîne déjà rendue
+ */
+typedef struct
+{
+    TTF_Font *font;                 // Clé: police (NULL = entrée libre)
+    SDL_Color color;                // Clé: couleur
+    uint32_t hash;                  // Hachage de la clé (comparaison rapide)
+    char text[TEXT_CACHE_MAX_LEN];  // Clé: texte
+    SDL_Texture *texture;           // Chaîne rendue
+    int w, h;                       // Taille de la texture
+    uint64_t last_used;             // Date d'utilisation (LRU)
+} TextCacheEntry;
+
+/*
+ * Structure TextCache - Atlas et cache de chaînes d'un renderer
+ */
+typedef struct
+{
+    SDL_Renderer *renderer;
+    GlyphAtlas atlases[TEXT_MAX_FONTS];
+    TextCacheEntry entries[TEXT_CACHE_SLOTS];
+    uint64_t clock;                               // Compteur d'utilisation
+    int draw_calls;                               // Appels de dessin (remis
+                                                  // à zéro par le renderer)
+    SDL_Vertex vertices[TEXT_MAX_GLYPHS * 4];     // Quads des glyphes
+    int indices[TEXT_MAX_GLYPHS * 6];
+} TextCache;
+
+/*
+ * text_cache_init - Prépare un cache vide pour un renderer
+ *
+ * Paramètres:
+ *   cache: Le cache à initialiser
+ *   renderer: Le renderer SDL qui créera les textures
+ */
+void text_cache_init(TextCache *cache, SDL_Renderer *renderer);
+
+/*
+ * text_cache_destroy - Libère toutes les textures du cache
+ *
+ * Paramètres:
+ *   cache: Le cache à vider
+ */
+void text_cache_destroy(TextCache *cache);
+
+/*
+ * text_draw - Dessine un libellé en passant par le cache de chaînes
+ *
+ * Rendu exact de SDL_ttf (crénage, UTF-8). La chaîne n'est rastérisée
+ * qu'au premier affichage (ou après éviction de l'entrée la moins
+ * récemment utilisée).
+ *
+ * Paramètres:
+ *   cache: Le cache
+ *   font: Police à utiliser
+ *   text: Texte à afficher
+ *   x, y: Position du coin haut gauche
+ *   color: Couleur du texte
+ */
+void text_draw(TextCache *cache, TTF_Font *font, const char *text,
+               int x, int y, SDL_Color color);
+
+/*
+ * text_draw_glyphs - Dessine un texte à partir de l'atlas de la police
+ *
+ * Pour les textes qui changent souvent (compteurs, valeurs): aucune
+ * allocation ni rastérisation, un seul appel de dessin. L'atlas est
+ * construit au premier usage de la police. Les caractères hors ASCII
+ * imprimable sont ignorés.
+ *
+ * Paramètres:
+ *   cache: Le cache
+ *   font: Police à utiliser
+ *   text: Texte à afficher
+ *   x, y: Position du coin haut gauche
+ *   color: Couleur du texte
+ *
+ * Retour: false si l'atlas n'a pas pu être construit
+ */
+bool text_draw_glyphs(TextCache *cache, TTF_Font *font, const char *text,
+                      int x, int y, SDL_Color color);
+
+#endif /* TEXT_H */
@@ -0,0 +1,124 @@
+/*
+ * trace.h - Trace des frames et des événements de jeu (--trace)
+ *
+ * Enregistre la durée de chaque phase de la boucle (mêmes phases que
+ * profile.h) et les événements de la partie (pièce fixée, lignes, game
+ * over, rotation décalée) dans des tampons circulaires alloués à
+ * l'ouverture: aucune allocation ni écriture de fichier pendant la
+ * partie. À la fermeture, les derniers événements sont écrits au format
+ * JSON "trace_event" de Chrome (chrome://tracing, Perfetto).
+ *
+ * Chaque thread a son propre tampon (un seul écrivain, pas de verrou).
+ * Désactivée, chaque appel se limite à un test.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "game.h"
+#include "profile.h"
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Événements gardés par thread (les plus anciens sont écrasés)
+#define TRACE_CAPACITY 65536
+
+/*
+ * TraceThread - Tampons de la trace, un par thread écrivain
+ */
+typedef enum
+{
+    TRACE_THREAD_MAIN,
+    TRACE_THREAD_SIM,
+    TRACE_THREAD_COUNT
+} TraceThread;
+
+/*
+ * Structure TraceEvent - Un événement enregistré
+ *
+ * - name, arg: Noms de l'événement et de sa valeur (chaînes statiques,
+ *   arg NULL si aucune valeur)
+ * - start, duration: Début et durée en unités du compteur (durée 0 et
+ *   instant pour un événement ponctuel)
+ * - instant: Événement ponctuel (sinon: phase avec une durée)
+ */
+typedef struct
+{
+    const char *name;
+    const char *arg;
+    Uint64 start;
+    Uint64 duration;
+    int value;
+    bool instant;
+} TraceEvent;
+
+/*
+ * Structure TraceRing - Tampon circulaire d'un thread
+ *
+ * - written: Événements écrits depuis l'ouverture (l'index courant est
+ *   written % TRACE_CAPACITY)
+ */
+typedef struct
+{
+    TraceEvent *events;
+    Uint64 written;
+} TraceRing;
+
+/*
+ * trace_open - Active la trace
+ *
+ * Ouvre le fichier tout de suite (un chemin invalide est signalé au
+ * lancement, pas à la fermeture) et alloue les tampons. À appeler
+ * avant de lancer la simulation.
+ *
+ * Paramètres:
+ *   path: Fichier JSON à écrire à la fermeture
+ *
+ * Retour: true si la trace est active
+ */
+bool trace_open(const char *path);
+
+/*
+ * trace_close - Écrit la trace et libère les tampons
+ *
+ * À appeler une fois la simulation arrêtée. Sans effet si la trace
+ * n'est pas active.
+ */
+void trace_close(void);
+
+/*
+ * trace_begin - Début d'une phase
+ *
+ * Paramètres:
+ *   phase: La phase (PROFILE_UPDATE sur le thread de simulation, les
+ *          autres sur le thread SDL)
+ */
+void trace_begin(ProfilePhase phase);
+
+/*
+ * trace_end - Fin d'une phase: enregistre sa durée
+ *
+ * Paramètres:
+ *   phase: La phase
+ */
+void trace_end(ProfilePhase phase);
+
+/*
+ * trace_game_event - Crochet d'événements du jeu (GameEventHook)
+ *
+ * À appeler depuis le crochet du jeu (game_set_event_hook): le jeu
+ * n'avance que sur le thread de simulation, les événements vont dans
+ * son tampon.
+ *
+ * Paramètres:
+ *   user: Inutilisé
+ *   event: L'événement
+ *   value: Sa valeur
+ */
+void trace_game_event(void *user, GameEvent event, int value);
+
+// Début et fin d'une phase pour le profil (PROFILE=1) et la trace
+#define PHASE_BEGIN(phase) (PROFILE_BEGIN(phase), trace_begin(phase))
+#define PHASE_END(phase) (PROFILE_END(phase), trace_end(phase))
+
+#endif /* TRACE_H */
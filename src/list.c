@@ -3,15 +3,206 @@
  */
 
 #include "include/list.h"
+#include "include/alloc.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+
+/*
+ * Slab - Bloc de mémoire contenant LIST_SLAB_SIZE blocs
+ *
+ * Les slabs ne sont jamais rendus au système pendant la partie:
+ * leurs blocs circulent entre les listes et la freelist.
+ */
+typedef struct BlockSlab
+{
+    struct BlockSlab *next;
+    Block blocks[LIST_SLAB_SIZE];
+} BlockSlab;
+
+// Pool global partagé par toutes les listes
+static BlockSlab *slabs = NULL;
+static Block *free_blocks = NULL;
+static ListAllocStats stats = {0, 0, 0, 0, 0};
+
+/*
+ * Alloue un nouveau slab et chaîne ses blocs dans la freelist
+ */
+static bool pool_grow(void)
+{
+    BlockSlab *slab = (BlockSlab *)alloc_malloc(sizeof(BlockSlab));
+    if (slab == NULL)
+    {
+        fprintf(stderr, "Erreur: Impossible d'allouer un slab de blocs\n");
+        return false;
+    }
+
+    for (int i = 0; i < LIST_SLAB_SIZE - 1; i++)
+    {
+        slab->blocks[i].next = &slab->blocks[i + 1];
+    }
+    slab->blocks[LIST_SLAB_SIZE - 1].next = free_blocks;
+    free_blocks = &slab->blocks[0];
+
+    slab->next = slabs;
+    slabs = slab;
+
+    stats.slab_allocs++;
+    stats.blocks_free += LIST_SLAB_SIZE;
+    return true;
+}
+
+/*
+ * Prend un bloc dans la freelist (agrandit le pool si elle est vide)
+ */
+static Block *pool_take(void)
+{
+    if (free_blocks == NULL && !pool_grow())
+        return NULL;
+
+    Block *block = free_blocks;
+    free_blocks = block->next;
+
+    stats.block_allocs++;
+    stats.blocks_live++;
+    stats.blocks_free--;
+    return block;
+}
+
+/*
+ * Rend une chaîne de count blocs (first..last) à la freelist en O(1)
+ */
+static void pool_give_chain(Block *first, Block *last, int count)
+{
+    if (first == NULL)
+        return;
+
+    last->next = free_blocks;
+    free_blocks = first;
+
+    stats.block_frees += count;
+    stats.blocks_live -= count;
+    stats.blocks_free += count;
+}
+
+/*
+ * Préalloue des blocs dans le pool
+ */
+bool list_pool_reserve(int count)
+{
+    while ((int)stats.blocks_free < count)
+    {
+        if (!pool_grow())
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Libère tous les slabs du pool
+ */
+void list_pool_release(void)
+{
+    while (slabs != NULL)
+    {
+        BlockSlab *next = slabs->next;
+        alloc_free(slabs);
+        slabs = next;
+    }
+
+    free_blocks = NULL;
+    stats.blocks_live = 0;
+    stats.blocks_free = 0;
+}
+
+/*
+ * Retourne les compteurs du pool
+ */
+ListAllocStats list_alloc_stats(void)
+{
+    return stats;
+}
+
+/*
+ * Seau de l'index correspondant à la ligne y
+ * (LIST_INDEX_ROWS = seau de débordement pour les y hors index)
+ */
+static int row_bucket(int y)
+{
+    return (y >= 0 && y < LIST_INDEX_ROWS) ? y : LIST_INDEX_ROWS;
+}
+
+/*
+ * Remet l'index par ligne à zéro
+ */
+static void index_reset(BlockList *list)
+{
+    memset(list->rows, 0, sizeof(list->rows));
+    memset(list->row_counts, 0, sizeof(list->row_counts));
+}
+
+/*
+ * Range un bloc dans le seau de sa ligne
+ */
+static void index_insert(BlockList *list, Block *block)
+{
+    int bucket = row_bucket(block->y);
+    block->row_next = list->rows[bucket];
+    list->rows[bucket] = block;
+    list->row_counts[bucket]++;
+}
+
+/*
+ * Retire un bloc du seau de sa ligne
+ */
+static void index_unlink(BlockList *list, Block *block)
+{
+    int bucket = row_bucket(block->y);
+    Block **link = &list->rows[bucket];
+    while (*link != NULL && *link != block)
+    {
+        link = &(*link)->row_next;
+    }
+
+    if (*link == block)
+    {
+        *link = block->row_next;
+        list->row_counts[bucket]--;
+    }
+}
+
+/*
+ * Détache un bloc de la chaîne principale en O(1)
+ */
+static void chain_unlink(BlockList *list, Block *block)
+{
+    if (block->prev == NULL)
+    {
+        list->head = block->next;
+    }
+    else
+    {
+        block->prev->next = block->next;
+    }
+
+    if (block->next == NULL)
+    {
+        list->tail = block->prev;
+    }
+    else
+    {
+        block->next->prev = block->prev;
+    }
+
+    list->count--;
+}
 
 /*
  * Crée une nouvelle liste vide
  */
 BlockList *list_create(void)
 {
-    BlockList *list = (BlockList *)malloc(sizeof(BlockList));
+    BlockList *list = (BlockList *)alloc_malloc(sizeof(BlockList));
     if (list == NULL)
     {
         fprintf(stderr, "Erreur: Impossible d'allouer la mémoire pour la liste\n");
@@ -19,7 +210,9 @@ BlockList *list_create(void)
     }
 
     list->head = NULL;
+    list->tail = NULL;
     list->count = 0;
+    index_reset(list);
 
     return list;
 }
@@ -32,26 +225,19 @@ void list_destroy(BlockList *list)
     if (list == NULL)
         return;
 
-    Block *current = list->head;
-    while (current != NULL)
-    {
-        Block *next = current->next;
-        free(current);
-        current = next;
-    }
-
-    free(list);
+    pool_give_chain(list->head, list->tail, list->count);
+    alloc_free(list);
 }
 
 /*
  * Ajoute un bloc à la fin de la liste
  */
-bool list_add(BlockList *list, int x, int y, SDL_Color color)
+bool list_add(BlockList *list, int x, int y, Color color)
 {
     if (list == NULL)
         return false;
 
-    Block *new_block = (Block *)malloc(sizeof(Block));
+    Block *new_block = pool_take();
     if (new_block == NULL)
     {
         fprintf(stderr, "Erreur: Impossible d'allouer un nouveau bloc\n");
@@ -62,6 +248,7 @@ bool list_add(BlockList *list, int x, int y, SDL_Color color)
     new_block->y = y;
     new_block->color = color;
     new_block->next = NULL;
+    new_block->prev = list->tail;
 
     if (list->head == NULL)
     {
@@ -69,13 +256,10 @@ bool list_add(BlockList *list, int x, int y, SDL_Color color)
     }
     else
     {
-        Block *current = list->head;
-        while (current->next != NULL)
-        {
-            current = current->next;
-        }
-        current->next = new_block;
+        list->tail->next = new_block;
     }
+    list->tail = new_block;
+    index_insert(list, new_block);
 
     list->count++;
     return true;
@@ -83,20 +267,22 @@ bool list_add(BlockList *list, int x, int y, SDL_Color color)
 
 /*
  * Recherche un bloc à une position donnée
+ *
+ * Seul le seau de la ligne y est parcouru.
  */
 Block *list_find(BlockList *list, int x, int y)
 {
     if (list == NULL)
         return NULL;
 
-    Block *current = list->head;
+    Block *current = list->rows[row_bucket(y)];
     while (current != NULL)
     {
         if (current->x == x && current->y == y)
         {
             return current;
         }
-        current = current->next;
+        current = current->row_next;
     }
 
     return NULL;
@@ -107,55 +293,32 @@ Block *list_find(BlockList *list, int x, int y)
  */
 bool list_remove(BlockList *list, int x, int y)
 {
-    if (list == NULL || list->head == NULL)
+    Block *block = list_find(list, x, y);
+    if (block == NULL)
         return false;
 
-    Block *current = list->head;
-    Block *previous = NULL;
-
-    while (current != NULL)
-    {
-        if (current->x == x && current->y == y)
-        {
-            if (previous == NULL)
-            {
-                list->head = current->next;
-            }
-            else
-            {
-                previous->next = current->next;
-            }
-
-            free(current);
-            list->count--;
-            return true;
-        }
-
-        previous = current;
-        current = current->next;
-    }
-
-    return false;
+    index_unlink(list, block);
+    chain_unlink(list, block);
+    pool_give_chain(block, block, 1);
+    return true;
 }
 
 /*
  * Vide la liste sans la détruire
+ *
+ * Toute la chaîne est rendue au pool en une seule opération.
  */
 void list_clear(BlockList *list)
 {
     if (list == NULL)
         return;
 
-    Block *current = list->head;
-    while (current != NULL)
-    {
-        Block *next = current->next;
-        free(current);
-        current = next;
-    }
+    pool_give_chain(list->head, list->tail, list->count);
 
     list->head = NULL;
+    list->tail = NULL;
     list->count = 0;
+    index_reset(list);
 }
 
 /*
@@ -222,4 +385,86 @@ int list_count(BlockList *list)
     if (list == NULL)
         return 0;
     return list->count;
-}
\ No newline at end of file
+}
+
+/*
+ * Retourne le nombre de blocs sur une ligne
+ */
+int list_row_count(BlockList *list, int y)
+{
+    if (list == NULL || y < 0 || y >= LIST_INDEX_ROWS)
+        return 0;
+    return list->row_counts[y];
+}
+
+/*
+ * Supprime tous les blocs d'une ligne
+ */
+int list_remove_row(BlockList *list, int y)
+{
+    if (list == NULL || y < 0 || y >= LIST_INDEX_ROWS)
+        return 0;
+
+    int removed = 0;
+    Block *current = list->rows[y];
+    while (current != NULL)
+    {
+        Block *next = current->row_next;
+        chain_unlink(list, current);
+        pool_give_chain(current, current, 1);
+        removed++;
+        current = next;
+    }
+
+    list->rows[y] = NULL;
+    list->row_counts[y] = 0;
+    return removed;
+}
+
+/*
+ * Descend d'un cran tous les blocs au-dessus de la ligne y
+ */
+void list_shift_rows_down(BlockList *list, int y)
+{
+    if (list == NULL || y < 0 || y >= LIST_INDEX_ROWS)
+        return;
+
+    // Faire glisser les seaux 0..y-1 vers 1..y
+    memmove(&list->rows[1], &list->rows[0], y * sizeof(list->rows[0]));
+    memmove(&list->row_counts[1], &list->row_counts[0], y * sizeof(list->row_counts[0]));
+    list->rows[0] = NULL;
+    list->row_counts[0] = 0;
+
+    for (int row = 1; row <= y; row++)
+    {
+        for (Block *current = list->rows[row]; current != NULL; current = current->row_next)
+        {
+            current->y = row;
+        }
+    }
+
+    // Les blocs au-dessus de la grille (y < 0) descendent aussi et
+    // rejoignent la ligne 0 quand ils y arrivent
+    Block **link = &list->rows[LIST_INDEX_ROWS];
+    while (*link != NULL)
+    {
+        Block *current = *link;
+        if (current->y >= 0)
+        {
+            link = &current->row_next;
+            continue;
+        }
+
+        current->y++;
+        if (current->y == 0)
+        {
+            *link = current->row_next;
+            list->row_counts[LIST_INDEX_ROWS]--;
+            index_insert(list, current);
+        }
+        else
+        {
+            link = &current->row_next;
+        }
+    }
+}
@@ -0,0 +1,489 @@
+/*
+ * log.c - Journal asynchrone: tampon sans verrou et thread d'écriture
+ */
+
+#include "include/log.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Type d'argument attendu par une conversion
+ */
+typedef enum
+{
+    ARG_NONE,
+    ARG_SIGNED,
+    ARG_UNSIGNED,
+    ARG_DOUBLE,
+    ARG_STRING,
+    ARG_POINTER
+} ArgKind;
+
+/*
+ * Structure LogSpec - Une conversion du format
+ *
+ * - spec: La conversion sans modificateur de taille ni lettre finale
+ *   ("%-12" pour "%-12s"), complétée au formatage
+ * - length: Modificateur de taille: 0, 'h', 'l', 'q' (ll) ou 'z'
+ * - conversion: Lettre de conversion (0 si le format est tronqué)
+ */
+typedef struct
+{
+    char spec[16];
+    char length;
+    char conversion;
+} LogSpec;
+
+// Tampon (écrit par tous les threads, lu par le thread d'écriture)
+static LogRecord records[LOG_CAPACITY];
+static SDL_atomic_t tail;       // Prochain ticket des écrivains
+static unsigned int head;       // Prochaine case lue (thread d'écriture)
+static SDL_atomic_t dropped;    // Messages perdus (tampon plein)
+static SDL_atomic_t running;    // Journal asynchrone ouvert
+static SDL_atomic_t min_level;  // LogLevel minimal écrit
+static SDL_sem *wakeup = NULL;  // Une unité par message publié
+static SDL_Thread *writer = NULL;
+
+static const char *level_names[] = {"debug", "info", "warn", "error"};
+
+/*
+ * Lit la conversion qui commence à p (sur le '%')
+ *
+ * Retour: Position après la conversion
+ */
+static const char *parse_spec(const char *p, LogSpec *out)
+{
+    size_t n = 0;
+
+    // '%', drapeaux, largeur et précision (place gardée pour "ll" et
+    // la lettre finale)
+    out->spec[n++] = *p++;
+    while (*p != '\0' && strchr("-+ #0123456789.", *p) != NULL)
+    {
+        if (n < sizeof(out->spec) - 4)
+        {
+            out->spec[n++] = *p;
+        }
+        p++;
+    }
+    out->spec[n] = '\0';
+
+    out->length = 0;
+    if (*p == 'h')
+    {
+        out->length = 'h';
+        p += (p[1] == 'h') ? 2 : 1;
+    }
+    else if (*p == 'l')
+    {
+        out->length = (p[1] == 'l') ? 'q' : 'l';
+        p += (p[1] == 'l') ? 2 : 1;
+    }
+    else if (*p == 'z')
+    {
+        out->length = 'z';
+        p++;
+    }
+
+    out->conversion = *p;
+    return (*p != '\0') ? p + 1 : p;
+}
+
+/*
+ * Type d'argument d'une lettre de conversion
+ */
+static ArgKind arg_kind(char conversion)
+{
+    switch (conversion)
+    {
+    case 'd':
+    case 'i':
+    case 'c':
+        return ARG_SIGNED;
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+        return ARG_UNSIGNED;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+        return ARG_DOUBLE;
+    case 's':
+        return ARG_STRING;
+    case 'p':
+        return ARG_POINTER;
+    default:
+        return ARG_NONE;
+    }
+}
+
+/*
+ * Copie les valeurs brutes des arguments, dans l'ordre du format
+ *
+ * Retour: Nombre d'arguments copiés
+ */
+static int capture_args(const char *format, va_list args, LogValue *values)
+{
+    int count = 0;
+    LogSpec spec;
+
+    const char *p = format;
+    while (*p != '\0' && count < LOG_MAX_ARGS)
+    {
+        if (*p != '%')
+        {
+            p++;
+            continue;
+        }
+
+        p = parse_spec(p, &spec);
+        LogValue *value = &values[count];
+
+        switch (arg_kind(spec.conversion))
+        {
+        case ARG_SIGNED:
+            if (spec.length == 'q')
+                value->i = va_arg(args, long long);
+            else if (spec.length == 'l')
+                value->i = va_arg(args, long);
+            else if (spec.length == 'z')
+                value->i = (long long)va_arg(args, size_t);
+            else
+                value->i = va_arg(args, int);
+            break;
+
+        case ARG_UNSIGNED:
+            if (spec.length == 'q')
+                value->u = va_arg(args, unsigned long long);
+            else if (spec.length == 'l')
+                value->u = va_arg(args, unsigned long);
+            else if (spec.length == 'z')
+                value->u = va_arg(args, size_t);
+            else
+                value->u = va_arg(args, unsigned int);
+            break;
+
+        case ARG_DOUBLE:
+            value->f = va_arg(args, double);
+            break;
+
+        case ARG_STRING:
+            value->s = va_arg(args, const char *);
+            break;
+
+        case ARG_POINTER:
+            value->p = va_arg(args, void *);
+            break;
+
+        case ARG_NONE:
+            continue; // "%%" ou conversion inconnue
+        }
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ * Formate un message (thread d'écriture)
+ */
+static void format_record(const LogRecord *record, char *line, size_t size)
+{
+    size_t len = 0;
+    int index = 0;
+    LogSpec spec;
+    char conversion[4];
+
+    const char *p = record->format;
+    while (*p != '\0' && len + 1 < size)
+    {
+        if (*p != '%')
+        {
+            line[len++] = *p++;
+            continue;
+        }
+
+        p = parse_spec(p, &spec);
+        ArgKind kind = arg_kind(spec.conversion);
+        int written = 0;
+
+        if (spec.conversion == '%')
+        {
+            written = snprintf(line + len, size - len, "%%");
+        }
+        else if (kind == ARG_NONE)
+        {
+            continue;
+        }
+        else if (index >= record->count)
+        {
+            written = snprintf(line + len, size - len, "?");
+        }
+        else
+        {
+            const LogValue *value = &record->args[index++];
+
+            // Les entiers sont gardés en long long: la conversion l'indique
+            bool wide = (kind == ARG_UNSIGNED || (kind == ARG_SIGNED && spec.conversion != 'c'));
+            snprintf(conversion, sizeof(conversion), "%s%c", wide ? "ll" : "", spec.conversion);
+            strcat(spec.spec, conversion);
+
+            switch (kind)
+            {
+            case ARG_SIGNED:
+                if (wide)
+                    written = snprintf(line + len, size - len, spec.spec, value->i);
+                else
+                    written = snprintf(line + len, size - len, spec.spec, (int)value->i);
+                break;
+            case ARG_UNSIGNED:
+                written = snprintf(line + len, size - len, spec.spec, value->u);
+                break;
+            case ARG_DOUBLE:
+                written = snprintf(line + len, size - len, spec.spec, value->f);
+                break;
+            case ARG_STRING:
+                written = snprintf(line + len, size - len, spec.spec,
+                                   (value->s != NULL) ? value->s : "(null)");
+                break;
+            case ARG_POINTER:
+                written = snprintf(line + len, size - len, spec.spec, value->p);
+                break;
+            case ARG_NONE:
+                break;
+            }
+        }
+
+        // snprintf renvoie la longueur voulue: tronquer à la place restante
+        if (written > 0)
+        {
+            len += ((size_t)written < size - len) ? (size_t)written : size - len - 1;
+        }
+    }
+
+    line[len] = '\0';
+}
+
+/*
+ * Réserve une case libre (plusieurs écrivains: le ticket est pris par
+ * compare-and-swap)
+ *
+ * Retour: La case, ou NULL si le tampon est plein
+ */
+static LogRecord *ring_claim(unsigned int *ticket)
+{
+    unsigned int pos = (unsigned int)SDL_AtomicGet(&tail);
+
+    for (;;)
+    {
+        LogRecord *record = &records[pos % LOG_CAPACITY];
+        int diff = (int)((unsigned int)SDL_AtomicGet(&record->sequence) - pos);
+
+        if (diff == 0)
+        {
+            if (SDL_AtomicCAS(&tail, (int)pos, (int)(pos + 1u)))
+            {
+                // Le thread d'écriture a fini de lire la case
+                SDL_MemoryBarrierAcquire();
+                *ticket = pos;
+                return record;
+            }
+        }
+        else if (diff < 0)
+        {
+            return NULL; // Case pas encore lue: tampon plein
+        }
+
+        pos = (unsigned int)SDL_AtomicGet(&tail);
+    }
+}
+
+/*
+ * Écrit tous les messages publiés, dans l'ordre des tickets
+ */
+static void drain(void)
+{
+    char line[LOG_LINE_MAX];
+
+    for (;;)
+    {
+        LogRecord *record = &records[head % LOG_CAPACITY];
+        if (SDL_AtomicGet(&record->sequence) != (int)(head + 1u))
+            break;
+
+        // Champs de la case lus après sa publication
+        SDL_MemoryBarrierAcquire();
+
+        format_record(record, line, sizeof(line));
+        FILE *stream = (record->level >= LOG_WARN) ? stderr : stdout;
+
+        // Case libre pour le passage suivant avant l'écriture (lente),
+        // une fois sa lecture terminée
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(&record->sequence, (int)(head + LOG_CAPACITY));
+        head++;
+
+        fputs(line, stream);
+    }
+
+    fflush(stdout);
+
+    // Messages perdus: le tampon était plein, donc tous ceux qui les
+    // précédaient viennent d'être écrits. Le signaler après eux.
+    int lost = SDL_AtomicSet(&dropped, 0);
+    if (lost > 0)
+    {
+        fprintf(stderr, "Journal: %d messages perdus\n", lost);
+    }
+}
+
+/*
+ * Thread d'écriture: dort jusqu'au prochain message
+ */
+static int writer_main(void *data)
+{
+    (void)data;
+
+    for (;;)
+    {
+        SDL_SemWait(wakeup);
+
+        // Arrêt demandé: les messages déjà publiés sont écrits d'abord
+        bool stop = !SDL_AtomicGet(&running);
+        drain();
+        if (stop)
+            break;
+    }
+
+    return 0;
+}
+
+/*
+ * Lance le thread d'écriture
+ */
+bool log_open(void)
+{
+    if (SDL_AtomicGet(&running))
+        return true;
+
+    for (int i = 0; i < LOG_CAPACITY; i++)
+    {
+        SDL_AtomicSet(&records[i].sequence, i);
+    }
+    SDL_AtomicSet(&tail, 0);
+    SDL_AtomicSet(&dropped, 0);
+    head = 0;
+
+    wakeup = SDL_CreateSemaphore(0);
+    if (wakeup == NULL)
+    {
+        fprintf(stderr, "Erreur SDL_CreateSemaphore: %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Les messages directs précèdent ceux du thread
+    fflush(stdout);
+
+    SDL_AtomicSet(&running, 1);
+    writer = SDL_CreateThread(writer_main, "log", NULL);
+    if (writer == NULL)
+    {
+        fprintf(stderr, "Erreur SDL_CreateThread: %s\n", SDL_GetError());
+        SDL_AtomicSet(&running, 0);
+        SDL_DestroySemaphore(wakeup);
+        wakeup = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Écrit les messages en attente et arrête le thread
+ */
+void log_close(void)
+{
+    if (!SDL_AtomicGet(&running))
+        return;
+
+    SDL_AtomicSet(&running, 0);
+    SDL_SemPost(wakeup);
+    SDL_WaitThread(writer, NULL);
+    writer = NULL;
+
+    SDL_DestroySemaphore(wakeup);
+    wakeup = NULL;
+}
+
+/*
+ * Sévérité minimale écrite
+ */
+void log_set_level(LogLevel level)
+{
+    SDL_AtomicSet(&min_level, (int)level);
+}
+
+/*
+ * Lit une sévérité
+ */
+bool log_level_from_name(const char *name, LogLevel *level)
+{
+    if (name == NULL || level == NULL)
+        return false;
+
+    for (int l = LOG_DEBUG; l <= LOG_ERROR; l++)
+    {
+        if (strcmp(name, level_names[l]) == 0)
+        {
+            *level = (LogLevel)l;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Ajoute un message au journal
+ */
+void log_write(LogLevel level, const char *format, ...)
+{
+    if (format == NULL || (int)level < SDL_AtomicGet(&min_level))
+        return;
+
+    va_list args;
+    va_start(args, format);
+
+    // Journal fermé: écriture directe
+    if (!SDL_AtomicGet(&running))
+    {
+        vfprintf((level >= LOG_WARN) ? stderr : stdout, format, args);
+        va_end(args);
+        return;
+    }
+
+    unsigned int ticket;
+    LogRecord *record = ring_claim(&ticket);
+    if (record == NULL)
+    {
+        SDL_AtomicAdd(&dropped, 1);
+        va_end(args);
+        return;
+    }
+
+    record->level = level;
+    record->format = format;
+    record->count = capture_args(format, args, record->args);
+    va_end(args);
+
+    // Publier la case (champs écrits avant le numéro: SDL_AtomicSet
+    // seul n'ordonne pas les écritures sur ARM), puis réveiller le
+    // thread d'écriture
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&record->sequence, (int)(ticket + 1u));
+    SDL_SemPost(wakeup);
+}
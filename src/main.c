@@ -9,17 +9,30 @@
 
 #include "include/game.h"
 #include "include/render.h"
+#include "include/sim.h"
+#include "include/pacer.h"
+#include "include/profile.h"
+#include "include/trace.h"
+#include "include/perf.h"
+#include "include/log.h"
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
-// FPS cible
-#define TARGET_FPS 60
-#define FRAME_DELAY (1000 / TARGET_FPS)
+// Veille (pause, game over): attente maximale d'un événement avant de
+// revérifier l'instantané (ms)
+#define IDLE_WAIT_MS 500
 
 /*
  * Gère les événements clavier
+ *
+ * Les actions de jeu sont envoyées au thread de simulation; l'état
+ * affiché (game over...) est celui du dernier instantané.
  */
-void handle_input(SDL_Event *event, GameState *game, Renderer *renderer)
+void handle_input(SDL_Event *event, Simulation *sim, const GameSnapshot *game,
+                  Renderer *renderer)
 {
     if (event->type == SDL_QUIT)
     {
@@ -27,17 +40,33 @@ void handle_input(SDL_Event *event, GameState *game, Renderer *renderer)
         return;
     }
 
+    // Redimensionnement, perte des textures: décor à redessiner
+    render_handle_event(renderer, event);
+
     if (event->type == SDL_KEYDOWN)
     {
         SDL_Keycode key = event->key.keysym.sym;
 
+        // F1: affichage des performances, à tout moment
+        if (key == SDLK_F1)
+        {
+            renderer->show_hud = !renderer->show_hud;
+            return;
+        }
+
+        // F3: profil des phases (build PROFILE=1), à tout moment
+        if (key == SDLK_F3)
+        {
+            PROFILE_DUMP();
+            return;
+        }
+
         // Game over: seules R et ESC fonctionnent
         if (game->game_over)
         {
             if (key == SDLK_r)
             {
-                game_reset(game);
-                printf("Nouvelle partie!\n");
+                sim_push(sim, SIM_CMD_RESET);
             }
             else if (key == SDLK_ESCAPE)
             {
@@ -50,50 +79,48 @@ void handle_input(SDL_Event *event, GameState *game, Renderer *renderer)
         switch (key)
         {
         case SDLK_LEFT:
-            game_move_piece(game, -1, 0);
+            sim_push(sim, SIM_CMD_LEFT);
             break;
 
         case SDLK_RIGHT:
-            game_move_piece(game, 1, 0);
+            sim_push(sim, SIM_CMD_RIGHT);
             break;
 
         case SDLK_DOWN:
-            // Descente rapide
-            if (game_move_piece(game, 0, 1))
-            {
-                game->score += 1; // Petit bonus
-            }
+            // Descente rapide (+1 point par case)
+            sim_push(sim, SIM_CMD_SOFT_DROP);
             break;
 
         case SDLK_UP:
         case SDLK_SPACE:
-            // Rotation
-            game_rotate_piece(game);
+            // Rotation horaire
+            sim_push(sim, SIM_CMD_ROTATE_CW);
+            break;
+
+        case SDLK_z:
+            // Rotation anti-horaire
+            sim_push(sim, SIM_CMD_ROTATE_CCW);
+            break;
+
+        case SDLK_a:
+            // Demi-tour
+            sim_push(sim, SIM_CMD_ROTATE_180);
             break;
 
         case SDLK_w:
         case SDLK_x:
             // Hard drop (chute instantanée)
-            game_drop_piece(game);
+            sim_push(sim, SIM_CMD_HARD_DROP);
             break;
 
         case SDLK_p:
             // Pause
-            game_toggle_pause(game);
-            if (game->paused)
-            {
-                printf("=== PAUSE ===\n");
-            }
-            else
-            {
-                printf("=== REPRISE ===\n");
-            }
+            sim_push(sim, SIM_CMD_PAUSE);
             break;
 
         case SDLK_r:
             // Restart
-            game_reset(game);
-            printf("Nouvelle partie!\n");
+            sim_push(sim, SIM_CMD_RESET);
             break;
 
         case SDLK_ESCAPE:
@@ -119,9 +146,12 @@ void print_controls(void)
     printf("║  CONTRÔLES:                               ║\n");
     printf("║  ←  → : Déplacer la pièce                ║\n");
     printf("║  ↓    : Descente rapide                  ║\n");
-    printf("║  ↑/SPC: Rotation                         ║\n");
+    printf("║  ↑/SPC: Rotation horaire                 ║\n");
+    printf("║  Z    : Rotation anti-horaire            ║\n");
+    printf("║  A    : Demi-tour                        ║\n");
     printf("║  W/X  : Hard drop (chute instantanée)    ║\n");
     printf("║  P    : Pause                            ║\n");
+    printf("║  F1   : Performances                     ║\n");
     printf("║  R    : Nouvelle partie                  ║\n");
     printf("║  ESC  : Quitter                          ║\n");
     printf("╠═══════════════════════════════════════════╣\n");
@@ -137,30 +167,107 @@ void print_controls(void)
 /*
  * Affiche les statistiques dans la console (debug)
  */
-void print_stats(GameState *game)
+void print_stats(const GameSnapshot *game)
 {
     static int last_score = -1;
 
     // N'afficher que si le score change
     if (game->score != last_score)
     {
-        printf("Score: %d | Niveau: %d | Lignes: %d | Blocs fixés: %d\n",
-               game->score, game->level, game->lines_cleared,
-               game->fixed_blocks->count);
+        log_write(LOG_DEBUG, "Score: %d | Niveau: %d | Lignes: %d | Blocs fixés: %d\n",
+                  game->score, game->level, game->lines_cleared,
+                  game->block_count);
         last_score = game->score;
     }
 }
 
+/*
+ * Crochet d'événements du jeu (thread de simulation): trace et console
+ */
+static void on_game_event(void *user, GameEvent event, int value)
+{
+    trace_game_event(user, event, value);
+
+    if (event == GAME_EVENT_GAME_OVER)
+    {
+        log_write(LOG_INFO, "GAME OVER! Score final: %d\n", value);
+    }
+}
+
 /*
  * Fonction principale
  */
 int main(int argc, char *argv[])
 {
-    (void)argc; // Éviter warning unused
-    (void)argv;
+    // Options de la ligne de commande
+    BoardMode board_mode = BOARD_MODE_TARGET;
+    bool vsync = false;
+    int target_fps = -1; // -1: défaut (PACER_DEFAULT_FPS, ou vsync seule)
+    const char *trace_path = NULL;
+    PerfSeal seal = PERF_SEAL_COUNT; // Allocations après la première frame
+    uint64_t seed = 0;
+    bool seed_set = false; // Sinon: graine tirée de l'horloge
+    LogLevel log_level = LOG_DEBUG;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--streaming") == 0)
+        {
+            board_mode = BOARD_MODE_STREAMING; // Grille en texture de streaming
+        }
+        else if (strcmp(argv[i], "--vsync") == 0)
+        {
+            vsync = true; // Synchronisation verticale
+        }
+        else if (strcmp(argv[i], "--uncapped") == 0)
+        {
+            target_fps = 0; // Pas de limite de FPS
+        }
+        else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+        {
+            target_fps = atoi(argv[++i]);
+            if (target_fps < 0)
+                target_fps = 0;
+        }
+        else if (strcmp(argv[i], "--alloc-abort") == 0)
+        {
+            seal = PERF_SEAL_ABORT; // Allocation du jeu fatale (débogage)
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            trace_path = argv[++i]; // Trace JSON écrite à la fermeture
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = strtoull(argv[++i], NULL, 0); // Suite de pièces rejouable
+            seed_set = true;
+        }
+        else if (strcmp(argv[i], "--log-level") == 0 && i + 1 < argc)
+        {
+            if (!log_level_from_name(argv[++i], &log_level))
+            {
+                fprintf(stderr, "Niveau de journal inconnu ignoré: %s\n", argv[i]);
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Option inconnue ignorée: %s\n", argv[i]);
+        }
+    }
 
     printf("Initialisation de Tetris...\n");
 
+    // Compter les allocations (affichage des perfs): avant toute
+    // fonction SDL
+    perf_count_allocations();
+
+    // Graine par défaut: après perf_count_allocations, qui doit
+    // précéder tout appel SDL
+    if (!seed_set)
+    {
+        seed = (uint64_t)time(NULL) ^ SDL_GetPerformanceCounter();
+    }
+    log_set_level(log_level); // Messages moins sévères ignorés
+
     // Initialiser le renderer
     Renderer *renderer = render_init();
     if (renderer == NULL)
@@ -168,94 +275,202 @@ int main(int argc, char *argv[])
         fprintf(stderr, "Erreur: Impossible d'initialiser le renderer\n");
         return 1;
     }
+    render_set_board_mode(renderer, board_mode);
+
+    // Ressources des écrans occasionnels (game over, perfs) créées
+    // maintenant plutôt qu'à leur premier affichage
+    render_prewarm(renderer);
+
+    // Cadencement: avec la vsync et sans FPS demandé, c'est
+    // render_present qui cadence
+    if (vsync && !render_set_vsync(renderer, true))
+    {
+        fprintf(stderr, "Avertissement: Synchronisation verticale indisponible\n");
+        vsync = false;
+    }
+    if (target_fps < 0)
+    {
+        target_fps = vsync ? 0 : PACER_DEFAULT_FPS;
+    }
+    FramePacer pacer;
+    pacer_init(&pacer, target_fps);
+
+    // Compteurs de l'affichage des performances (F1)
+    PerfStats perf;
+    perf_init(&perf);
+    renderer->perf = &perf;
 
     // Initialiser le jeu
-    GameState *game = game_init();
+    GameState *game = game_init(seed);
     if (game == NULL)
     {
         fprintf(stderr, "Erreur: Impossible d'initialiser le jeu\n");
         render_destroy(renderer);
         return 1;
     }
+    printf("Graine: %llu (--seed pour rejouer la même suite de pièces)\n",
+           (unsigned long long)seed);
+
+    // Trace: phases de la boucle et événements de la partie
+    if (trace_path != NULL && !trace_open(trace_path))
+    {
+        fprintf(stderr, "Avertissement: Trace désactivée\n");
+    }
+    game_set_event_hook(game, on_game_event, NULL);
 
     // Afficher les contrôles
     print_controls();
 
-    // Variables pour le timing
-    Uint32 last_time = SDL_GetTicks();
+    // Console: les messages de la boucle passent par le thread
+    // d'écriture du journal (sinon ils restent directs)
+    if (!log_open())
+    {
+        fprintf(stderr, "Avertissement: Journal asynchrone indisponible\n");
+    }
+
+    // Lancer la simulation: elle possède le jeu jusqu'à sim_stop
+    Simulation *sim = sim_start(game);
+    if (sim == NULL)
+    {
+        fprintf(stderr, "Erreur: Impossible de lancer la simulation\n");
+        log_close();
+        trace_close();
+        game_destroy(game);
+        list_pool_release();
+        render_destroy(renderer);
+        return 1;
+    }
 
-    // Boucle principale
+    // Boucle principale: événements et rendu uniquement
     SDL_Event event;
+    bool redraw = true;          // Écran à redessiner
+    uint32_t drawn_sequence = 0; // Instantané affiché en dernier
+    bool sealed = false;         // Allocations scellées?
 
     while (renderer->running)
     {
-        // Calculer delta time
-        Uint32 current_time = SDL_GetTicks();
-        float delta_time = (current_time - last_time) / 1000.0f;
-        last_time = current_time;
+        // Dernier état publié par la simulation
+        const GameSnapshot *snapshot = sim_latest(sim);
+        bool idle = snapshot->paused || snapshot->game_over;
+
+        // Veille: l'écran est à jour et rien ne bouge, dormir jusqu'au
+        // prochain événement (touche, fenêtre exposée, changement d'état
+        // signalé par la simulation)
+        if (idle && !redraw)
+        {
+            if (SDL_WaitEventTimeout(&event, IDLE_WAIT_MS))
+            {
+                handle_input(&event, sim, snapshot, renderer);
+                redraw = true;
+            }
+            pacer_resync(&pacer);
+        }
 
-        // Gérer les événements
+        // Gérer les événements (envoyés à la simulation)
+        PHASE_BEGIN(PROFILE_FRAME);
+        PHASE_BEGIN(PROFILE_EVENTS);
         while (SDL_PollEvent(&event))
         {
-            handle_input(&event, game, renderer);
+            handle_input(&event, sim, snapshot, renderer);
+            redraw = true;
         }
+        PHASE_END(PROFILE_EVENTS);
 
-        // Mettre à jour la logique du jeu
-        game_update(game, delta_time);
+        // Rendre l'état le plus récent (commandes déjà appliquées si la
+        // simulation a publié entre-temps)
+        snapshot = sim_latest(sim);
+        idle = snapshot->paused || snapshot->game_over;
+        if (!idle || snapshot->sequence != drawn_sequence)
+        {
+            redraw = true;
+        }
 
-        // Afficher les stats (debug)
-        print_stats(game);
+        if (redraw)
+        {
+            // Afficher les stats (debug)
+            print_stats(snapshot);
 
-        // === RENDU ===
+            // === RENDU ===
 
-        // Effacer l'écran
-        render_clear(renderer);
+            // Décor fixe (fond, grille, cadres): une copie de texture
+            PHASE_BEGIN(PROFILE_BACKGROUND);
+            render_background(renderer);
+            PHASE_END(PROFILE_BACKGROUND);
 
-        // Dessiner la grille
-        render_grid(renderer);
+            // Blocs fixés, pièce fantôme et pièce courante: seules les
+            // cases modifiées sont repeintes
+            PHASE_BEGIN(PROFILE_BOARD);
+            render_board(renderer, snapshot);
+            PHASE_END(PROFILE_BOARD);
 
-        // Dessiner les blocs fixés
-        render_fixed_blocks(renderer, game->fixed_blocks);
+            // Dessiner l'UI
+            PHASE_BEGIN(PROFILE_UI);
+            render_ui(renderer, snapshot);
+            PHASE_END(PROFILE_UI);
 
-        // Dessiner la pièce fantôme
-        if (!game->game_over && !game->paused)
-        {
-            render_ghost_piece(renderer, game);
-        }
+            PHASE_BEGIN(PROFILE_OVERLAY);
 
-        // Dessiner la pièce courante
-        if (!game->game_over)
-        {
-            render_piece(renderer, game->current_piece);
-        }
+            // Afficher l'écran de pause
+            if (snapshot->paused)
+            {
+                render_pause(renderer);
+            }
 
-        // Dessiner l'UI
-        render_ui(renderer, game);
+            // Afficher l'écran de game over
+            if (snapshot->game_over)
+            {
+                render_game_over(renderer, snapshot);
+            }
 
-        // Afficher l'écran de pause
-        if (game->paused)
-        {
-            render_pause(renderer);
+            PHASE_END(PROFILE_OVERLAY);
+
+            // Présenter le rendu
+            PHASE_BEGIN(PROFILE_PRESENT);
+            render_present(renderer);
+            PHASE_END(PROFILE_PRESENT);
+
+            perf_frame(&perf, snapshot, renderer->frame_draw_calls);
+
+            // Première frame présentée: tout est alloué, la boucle ne
+            // doit plus allouer
+            if (!sealed)
+            {
+                perf_seal_allocations(seal);
+                sealed = true;
+            }
+
+            drawn_sequence = snapshot->sequence;
+            redraw = false;
         }
+        PHASE_END(PROFILE_FRAME);
 
-        // Afficher l'écran de game over
-        if (game->game_over)
+        // Attendre l'échéance de la frame (en veille, c'est l'attente
+        // d'événement qui cadence)
+        if (!idle)
         {
-            render_game_over(renderer, game);
+            pacer_wait(&pacer);
         }
+    }
 
-        // Présenter le rendu
-        render_present(renderer);
+    pacer_report(&pacer);
 
-        // Limiter les FPS
-        SDL_Delay(FRAME_DELAY);
-    }
+    // La fermeture peut allouer
+    perf_seal_allocations(PERF_SEAL_NONE);
+    log_write(LOG_INFO, "Allocations après la première frame: %d\n", perf_late_allocations());
+
+    // Nettoyage: arrêter la simulation avant de relire le jeu
+    sim_stop(sim);
+    PROFILE_DUMP();
+    trace_close();
+
+    // Plus aucun autre thread n'écrit: vider le journal
+    log_close();
 
-    // Nettoyage
     printf("\nFermeture du jeu...\n");
     printf("Score final: %d\n", game->score);
 
     game_destroy(game);
+    list_pool_release();
     render_destroy(renderer);
 
     printf("Au revoir!\n");
@@ -267,38 +482,67 @@ int main(int argc, char *argv[])
  * EXPLICATION DE LA BOUCLE PRINCIPALE:
  * ====================================
  *
- * 1. TIMING:
- *    - On calcule delta_time pour avoir un jeu fluide
- *    - Indépendant de la vitesse du processeur
+ * 1. TIMING (thread de simulation, sim.c):
+ *    - La simulation avance par ticks entiers (SIM_TICK_RATE par seconde)
+ *    - Elle exécute autant de ticks que le temps écoulé l'exige
+ *    - Même graine (--seed) et même suite d'entrées = même partie,
+ *      quelle que soit la machine (pièces tirées par sacs de 7, rng.c)
  *
- * 2. INPUT (Événements):
+ * 2. INPUT (Événements, thread SDL):
  *    - SDL_PollEvent récupère tous les événements
  *    - Clavier, souris, fermeture de fenêtre
- *    - handle_input gère la logique associée
+ *    - handle_input envoie les actions à la simulation (file sans
+ *      verrou), qui se réveille et les applique aussitôt
  *
- * 3. UPDATE (Logique):
- *    - game_update applique la gravité
+ * 3. UPDATE (Logique, thread de simulation):
+ *    - game_update applique la gravité (tick par tick)
  *    - Vérifie les collisions
  *    - Fixe les pièces
  *    - Supprime les lignes complètes
+ *    - Publie un instantané (triple tampon): le rendu prend toujours
+ *      le plus récent, sans jamais bloquer la simulation
  *
- * 4. RENDER (Affichage):
- *    - render_clear efface l'écran précédent
+ * 4. RENDER (Affichage, thread SDL, à partir de l'instantané):
+ *    - render_background recouvre l'écran précédent avec le décor
+ *      pré-rendu (fond, grille, cadres: une seule copie de texture)
  *    - On dessine couche par couche:
- *      a. Grille de fond
- *      b. Blocs fixés
- *      c. Pièce fantôme (transparente)
- *      d. Pièce courante
- *      e. UI (score, next piece)
- *      f. Overlays (pause, game over)
+ *      a. Décor
+ *      b. Grille (texture gardée d'une frame à l'autre: blocs fixés,
+ *         pièce fantôme et pièce courante, seules les cases modifiées
+ *         sont repeintes)
+ *      c. UI (score, next piece, performances avec F1)
+ *      d. Overlays (pause, game over)
  *    - render_present affiche tout à l'écran
  *
- * 5. FPS LIMITING:
- *    - SDL_Delay pour limiter à 60 FPS
+ * 5. FPS LIMITING (pacer.c):
+ *    - Échéance absolue par frame au compteur haute résolution:
+ *      sommeil puis courte attente active, cadence indépendante du
+ *      temps de rendu
+ *    - --fps N, --uncapped, --vsync; les frames manquées sont signalées
  *    - Évite de consommer 100% du CPU
+ *    - make PROFILE=1: durée de chaque phase (p50/p99/max), affichée
+ *      avec F3 et à la fermeture (profile.c)
+ *    - Aucune allocation après la première frame: elles sont comptées
+ *      (--alloc-abort: la première allocation du jeu arrête le
+ *      programme)
+ *    - --trace fichier.json: phases et événements de la partie (pièce
+ *      fixée, lignes, game over, rotation décalée) au format de
+ *      chrome://tracing, écrits à la fermeture (trace.c)
+ *    - Console: les messages de la boucle sont écrits par le thread du
+ *      journal (log.c), la boucle n'attend jamais la console;
+ *      --log-level warn pour ne garder que les avertissements
+ *
+ * 6. VEILLE (pause, game over):
+ *    - La simulation dort jusqu'à la prochaine commande
+ *    - La boucle dort dans SDL_WaitEventTimeout et ne redessine que sur
+ *      un événement (touche, fenêtre exposée...) ou un nouvel instantané
+ *    - Entrée et sortie de veille sont signalées par un événement SDL
+ *      de la simulation: la reprise est immédiate
  *
  * Cette architecture sépare bien:
  * - La LOGIQUE (game.c) - Indépendante du rendu
+ * - La SIMULATION (sim.c) - Son propre thread: un rendu lent ne
+ *   retarde ni les entrées ni la gravité
  * - Le RENDU (render.c) - Indépendant de la logique
  * - L'ORCHESTRATION (main.c) - Coordination
  */
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*
+ * pacer.c - Cadencement des frames au compteur haute résolution
+ */
+
+#include "include/pacer.h"
+#include "include/log.h"
+
+/*
+ * Convertit une durée du compteur en millisecondes
+ */
+static double counts_to_ms(const FramePacer *pacer, Uint64 counts)
+{
+    return (double)counts * 1000.0 / (double)pacer->freq;
+}
+
+/*
+ * Affiche les frames en retard de la fenêtre écoulée, s'il y en a
+ */
+static void pacer_report_window(FramePacer *pacer, Uint64 now)
+{
+    if (now - pacer->window_start < PACER_REPORT_SECONDS * pacer->freq)
+        return;
+
+    if (pacer->window_missed > 0)
+    {
+        log_write(LOG_WARN, "Frames en retard: %llu/%llu (pire retard: %.1f ms)\n",
+                  (unsigned long long)pacer->window_missed,
+                  (unsigned long long)pacer->window_frames,
+                  counts_to_ms(pacer, pacer->window_worst));
+    }
+
+    pacer->window_start = now;
+    pacer->window_frames = 0;
+    pacer->window_missed = 0;
+    pacer->window_worst = 0;
+}
+
+/*
+ * Prépare le cadencement
+ */
+void pacer_init(FramePacer *pacer, int target_fps)
+{
+    if (pacer == NULL)
+        return;
+
+    pacer->freq = SDL_GetPerformanceFrequency();
+    pacer->period = (target_fps > 0) ? pacer->freq / (Uint64)target_fps : 0;
+    pacer->spin = pacer->freq * PACER_SPIN_MS / 1000;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    pacer->deadline = now + pacer->period;
+    pacer->frames = 0;
+    pacer->missed = 0;
+    pacer->window_start = now;
+    pacer->window_frames = 0;
+    pacer->window_missed = 0;
+    pacer->window_worst = 0;
+}
+
+/*
+ * Attend l'échéance: sommeil jusqu'à PACER_SPIN_MS avant, puis attente
+ * active jusqu'à l'échéance exacte
+ */
+void pacer_wait(FramePacer *pacer)
+{
+    if (pacer == NULL)
+        return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    pacer->frames++;
+    pacer->window_frames++;
+
+    if (pacer->period == 0)
+    {
+        // Sans limite: rien à attendre, aucune échéance à manquer
+        pacer_report_window(pacer, now);
+        return;
+    }
+
+    if (now > pacer->deadline)
+    {
+        // Frame manquée
+        Uint64 late = now - pacer->deadline;
+        pacer->missed++;
+        pacer->window_missed++;
+        if (late > pacer->window_worst)
+        {
+            pacer->window_worst = late;
+        }
+
+        // Plus d'une période de retard: repartir de maintenant
+        pacer->deadline = (late >= pacer->period) ? now + pacer->period
+                                                  : pacer->deadline + pacer->period;
+        pacer_report_window(pacer, now);
+        return;
+    }
+
+    // Dormir tant que l'échéance est à plus de PACER_SPIN_MS
+    while (pacer->deadline - now > pacer->spin)
+    {
+        Uint32 sleep_ms = (Uint32)((pacer->deadline - now - pacer->spin) * 1000 / pacer->freq);
+        SDL_Delay(sleep_ms > 0 ? sleep_ms : 1);
+        now = SDL_GetPerformanceCounter();
+        if (now >= pacer->deadline)
+            break;
+    }
+
+    // Attente active jusqu'à l'échéance exacte
+    while (now < pacer->deadline)
+    {
+        now = SDL_GetPerformanceCounter();
+    }
+
+    pacer->deadline += pacer->period;
+    pacer_report_window(pacer, now);
+}
+
+/*
+ * Repart de maintenant après une attente hors cadencement
+ */
+void pacer_resync(FramePacer *pacer)
+{
+    if (pacer == NULL)
+        return;
+
+    pacer->deadline = SDL_GetPerformanceCounter() + pacer->period;
+}
+
+/*
+ * Affiche le bilan des frames manquées
+ */
+void pacer_report(const FramePacer *pacer)
+{
+    if (pacer == NULL || pacer->period == 0)
+        return;
+
+    log_write(LOG_INFO, "Frames: %llu, en retard: %llu\n",
+              (unsigned long long)pacer->frames,
+              (unsigned long long)pacer->missed);
+}
@@ -0,0 +1,239 @@
+/*
+ * perf.c - Compteurs de performance (frames, simulation, allocations)
+ */
+
+#include "include/perf.h"
+#include "include/alloc.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Allocations comptées (tous threads), et depuis le scellement
+static SDL_atomic_t allocations;
+static SDL_atomic_t late_allocations;
+static SDL_atomic_t seal_mode; // PerfSeal
+
+// Fonctions mémoire de SDL d'origine
+static SDL_malloc_func real_malloc;
+static SDL_calloc_func real_calloc;
+static SDL_realloc_func real_realloc;
+static SDL_free_func real_free;
+
+/*
+ * Compte une allocation (et la signale si les allocations sont scellées)
+ *
+ * fatal: Allocation du jeu (alloc_malloc), fatale en PERF_SEAL_ABORT;
+ * celles internes à SDL (file d'événements, pilote de rendu) sont
+ * seulement comptées
+ */
+static void count_allocation(bool fatal)
+{
+    SDL_AtomicAdd(&allocations, 1);
+
+    int mode = SDL_AtomicGet(&seal_mode);
+    if (mode == PERF_SEAL_NONE)
+        return;
+
+    SDL_AtomicAdd(&late_allocations, 1);
+    if (mode == PERF_SEAL_ABORT && fatal)
+    {
+        fprintf(stderr, "Erreur: Allocation après la première frame\n");
+        abort();
+    }
+}
+
+/*
+ * Crochet de alloc_malloc
+ */
+static void count_hook(void *user, size_t size)
+{
+    (void)user;
+    (void)size;
+    count_allocation(true);
+}
+
+/*
+ * Fonctions mémoire de SDL qui comptent (realloc compte comme une
+ * allocation: elle peut en faire une)
+ */
+static void *SDLCALL counting_malloc(size_t size)
+{
+    count_allocation(false);
+    return real_malloc(size);
+}
+
+static void *SDLCALL counting_calloc(size_t nmemb, size_t size)
+{
+    count_allocation(false);
+    return real_calloc(nmemb, size);
+}
+
+static void *SDLCALL counting_realloc(void *mem, size_t size)
+{
+    count_allocation(false);
+    return real_realloc(mem, size);
+}
+
+static void SDLCALL counting_free(void *mem)
+{
+    real_free(mem);
+}
+
+/*
+ * Compte les allocations du jeu et de SDL
+ */
+void perf_count_allocations(void)
+{
+    SDL_AtomicSet(&allocations, 0);
+    SDL_AtomicSet(&late_allocations, 0);
+    SDL_AtomicSet(&seal_mode, PERF_SEAL_NONE);
+
+    // En cas d'échec, SDL garde ses fonctions: seules les allocations
+    // du jeu sont comptées
+    SDL_GetMemoryFunctions(&real_malloc, &real_calloc, &real_realloc, &real_free);
+    SDL_SetMemoryFunctions(counting_malloc, counting_calloc,
+                           counting_realloc, counting_free);
+
+    alloc_set_hook(count_hook, NULL);
+}
+
+/*
+ * Allocations comptées
+ */
+int perf_allocations(void)
+{
+    return SDL_AtomicGet(&allocations);
+}
+
+/*
+ * Change le sort des allocations à venir
+ */
+void perf_seal_allocations(PerfSeal mode)
+{
+    SDL_AtomicSet(&seal_mode, (int)mode);
+}
+
+/*
+ * Allocations depuis le scellement
+ */
+int perf_late_allocations(void)
+{
+    return SDL_AtomicGet(&late_allocations);
+}
+
+/*
+ * Remet les compteurs à zéro
+ */
+void perf_init(PerfStats *perf)
+{
+    if (perf == NULL)
+        return;
+
+    perf->freq = SDL_GetPerformanceFrequency();
+    perf->last_frame = SDL_GetPerformanceCounter();
+    perf->history_head = 0;
+    perf->history_count = 0;
+    perf->tick_mark = 0;
+    perf->tick_mark_time = perf->last_frame;
+    perf->ticks_per_second = 0.0f;
+    perf->alloc_mark = perf_allocations();
+    perf->frame_allocs = 0;
+    perf->frame_draw_calls = 0;
+}
+
+/*
+ * Enregistre une frame présentée
+ */
+void perf_frame(PerfStats *perf, const GameSnapshot *game, int draw_calls)
+{
+    if (perf == NULL || game == NULL)
+        return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // Durée depuis la frame précédente (cadencement compris)
+    perf->frame_ms[perf->history_head] =
+        (float)((double)(now - perf->last_frame) * 1000.0 / (double)perf->freq);
+    perf->history_head = (perf->history_head + 1) % PERF_HISTORY;
+    if (perf->history_count < PERF_HISTORY)
+    {
+        perf->history_count++;
+    }
+    perf->last_frame = now;
+
+    // Allocations depuis la frame précédente
+    int total = perf_allocations();
+    perf->frame_allocs = total - perf->alloc_mark;
+    perf->alloc_mark = total;
+    perf->frame_draw_calls = draw_calls;
+
+    // Ticks par seconde, sur une fenêtre (une nouvelle partie remet le
+    // tick à zéro: la fenêtre repart)
+    if (game->tick < perf->tick_mark)
+    {
+        perf->tick_mark = game->tick;
+        perf->tick_mark_time = now;
+    }
+    Uint64 window = now - perf->tick_mark_time;
+    if (window >= perf->freq * PERF_TICK_WINDOW_MS / 1000)
+    {
+        perf->ticks_per_second = (float)((double)(game->tick - perf->tick_mark) *
+                                         (double)perf->freq / (double)window);
+        perf->tick_mark = game->tick;
+        perf->tick_mark_time = now;
+    }
+}
+
+/*
+ * FPS moyennes sur l'historique
+ */
+float perf_fps(const PerfStats *perf)
+{
+    if (perf == NULL || perf->history_count == 0)
+        return 0.0f;
+
+    float total = 0.0f;
+    for (int i = 0; i < perf->history_count; i++)
+    {
+        total += perf->frame_ms[i];
+    }
+    return (total > 0.0f) ? 1000.0f * (float)perf->history_count / total : 0.0f;
+}
+
+/*
+ * 99e centile des durées de l'historique (tri par insertion d'une copie:
+ * appelé seulement quand l'affichage est visible)
+ */
+float perf_p99_ms(const PerfStats *perf)
+{
+    if (perf == NULL || perf->history_count == 0)
+        return 0.0f;
+
+    float sorted[PERF_HISTORY];
+    int count = perf->history_count;
+
+    for (int i = 0; i < count; i++)
+    {
+        float value = perf->frame_ms[i];
+        int j = i;
+        while (j > 0 && sorted[j - 1] > value)
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+
+    // Rang du centile, arrondi au-dessus
+    int rank = (count * 99 + 99) / 100;
+    return sorted[rank - 1];
+}
+
+/*
+ * Durée d'une frame de l'historique, de la plus ancienne à la dernière
+ */
+float perf_history(const PerfStats *perf, int age)
+{
+    int first = (perf->history_head - perf->history_count + PERF_HISTORY) % PERF_HISTORY;
+    return perf->frame_ms[(first + age) % PERF_HISTORY];
+}
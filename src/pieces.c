@@ -5,15 +5,13 @@
 #include "include/pieces.h"
 #include <stdlib.h>
 #include <stdio.h>
-#include <time.h>
-#include <math.h>
 
 /*
  * Définition des couleurs pour chaque type de pièce
  */
-SDL_Color piece_get_color(PieceType type)
+Color piece_get_color(PieceType type)
 {
-    SDL_Color color;
+    Color color;
     switch (type)
     {
     case PIECE_I:
@@ -69,216 +67,265 @@ SDL_Color piece_get_color(PieceType type)
 }
 
 /*
- * Crée une pièce selon son type
+ * Table des formes: pour chaque type et chaque état de rotation
+ * (0, R, 2, L dans le sens horaire), les 4 blocs relatifs au coin
+ * haut-gauche de la boîte de rotation (4x4 pour I, 3x3 sinon,
+ * O est centré dans une boîte de largeur 4 et ne tourne pas).
+ *
+ * Ce sont les orientations du Super Rotation System: tourner revient
+ * à lire une autre ligne de la table, sans calcul flottant.
  */
-Piece *piece_create(PieceType type)
+static const PieceCell PIECE_SHAPES[PIECE_COUNT][4][PIECE_BLOCKS] = {
+    [PIECE_I] = {
+        {{0, 1}, {1, 1}, {2, 1}, {3, 1}}, // 0
+        {{2, 0}, {2, 1}, {2, 2}, {2, 3}}, // R
+        {{0, 2}, {1, 2}, {2, 2}, {3, 2}}, // 2
+        {{1, 0}, {1, 1}, {1, 2}, {1, 3}}, // L
+    },
+    [PIECE_O] = {
+        {{1, 0}, {2, 0}, {1, 1}, {2, 1}}, // 0
+        {{1, 0}, {2, 0}, {1, 1}, {2, 1}}, // R
+        {{1, 0}, {2, 0}, {1, 1}, {2, 1}}, // 2
+        {{1, 0}, {2, 0}, {1, 1}, {2, 1}}, // L
+    },
+    [PIECE_T] = {
+        {{1, 0}, {0, 1}, {1, 1}, {2, 1}}, // 0
+        {{1, 0}, {1, 1}, {2, 1}, {1, 2}}, // R
+        {{0, 1}, {1, 1}, {2, 1}, {1, 2}}, // 2
+        {{1, 0}, {0, 1}, {1, 1}, {1, 2}}, // L
+    },
+    [PIECE_S] = {
+        {{1, 0}, {2, 0}, {0, 1}, {1, 1}}, // 0
+        {{1, 0}, {1, 1}, {2, 1}, {2, 2}}, // R
+        {{1, 1}, {2, 1}, {0, 2}, {1, 2}}, // 2
+        {{0, 0}, {0, 1}, {1, 1}, {1, 2}}, // L
+    },
+    [PIECE_Z] = {
+        {{0, 0}, {1, 0}, {1, 1}, {2, 1}}, // 0
+        {{2, 0}, {1, 1}, {2, 1}, {1, 2}}, // R
+        {{0, 1}, {1, 1}, {1, 2}, {2, 2}}, // 2
+        {{1, 0}, {0, 1}, {1, 1}, {0, 2}}, // L
+    },
+    [PIECE_J] = {
+        {{0, 0}, {0, 1}, {1, 1}, {2, 1}}, // 0
+        {{1, 0}, {2, 0}, {1, 1}, {1, 2}}, // R
+        {{0, 1}, {1, 1}, {2, 1}, {2, 2}}, // 2
+        {{1, 0}, {1, 1}, {0, 2}, {1, 2}}, // L
+    },
+    [PIECE_L] = {
+        {{2, 0}, {0, 1}, {1, 1}, {2, 1}}, // 0
+        {{1, 0}, {1, 1}, {1, 2}, {2, 2}}, // R
+        {{0, 1}, {1, 1}, {2, 1}, {0, 2}}, // 2
+        {{0, 0}, {1, 0}, {1, 1}, {1, 2}}, // L
+    },
+};
+
+/*
+ * Structure KickSet - Décalages à tester pour une rotation donnée
+ */
+typedef struct
 {
-    Piece *piece = (Piece *)malloc(sizeof(Piece));
-    if (piece == NULL)
-    {
-        fprintf(stderr, "Erreur: Impossible d'allouer la pièce\n");
-        return NULL;
-    }
+    int count;
+    PieceCell offsets[KICK_MAX_TESTS];
+} KickSet;
 
-    piece->blocks = list_create();
-    if (piece->blocks == NULL)
+/*
+ * Tables de wall kicks SRS, indexées par [sens][état de départ]
+ * (sens 0 = horaire, 1 = anti-horaire).
+ *
+ * Les valeurs de la Tetris Guideline sont données avec y vers le haut;
+ * elles sont ici inversées en y pour suivre la grille (y vers le bas).
+ * Le demi-tour n'existe pas dans le SRS d'origine: on utilise la table
+ * SRS+ courante, commune à toutes les pièces.
+ */
+static const KickSet KICKS_180[4] = {
+    {6, {{0, 0}, {0, -1}, {1, -1}, {-1, -1}, {1, 0}, {-1, 0}}},   // 0 -> 2
+    {6, {{0, 0}, {1, 0}, {1, -2}, {1, -1}, {0, -2}, {0, -1}}},    // R -> L
+    {6, {{0, 0}, {0, 1}, {-1, 1}, {1, 1}, {-1, 0}, {1, 0}}},      // 2 -> 0
+    {6, {{0, 0}, {-1, 0}, {-1, -2}, {-1, -1}, {0, -2}, {0, -1}}}, // L -> R
+};
+
+static const KickSet KICKS_JLSTZ[2][4] = {
+    // Sens horaire
     {
-        free(piece);
-        return NULL;
-    }
-
-    piece->type = type;
-    piece->rotation = 0;
-
-    SDL_Color color = piece_get_color(type);
-    int start_x = 4;
-    int start_y = 0;
-
-    switch (type)
+        {5, {{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}}},  // 0 -> R
+        {5, {{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}}},    // R -> 2
+        {5, {{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}}},     // 2 -> L
+        {5, {{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}}, // L -> 0
+    },
+    // Sens anti-horaire
     {
-    case PIECE_I:
-        list_add(piece->blocks, start_x - 1, start_y, color);
-        list_add(piece->blocks, start_x, start_y, color);
-        list_add(piece->blocks, start_x + 1, start_y, color);
-        list_add(piece->blocks, start_x + 2, start_y, color);
-        break;
-
-    case PIECE_O:
-        list_add(piece->blocks, start_x, start_y, color);
-        list_add(piece->blocks, start_x + 1, start_y, color);
-        list_add(piece->blocks, start_x, start_y + 1, color);
-        list_add(piece->blocks, start_x + 1, start_y + 1, color);
-        break;
-
-    case PIECE_T:
-        list_add(piece->blocks, start_x, start_y, color);
-        list_add(piece->blocks, start_x - 1, start_y + 1, color);
-        list_add(piece->blocks, start_x, start_y + 1, color);
-        list_add(piece->blocks, start_x + 1, start_y + 1, color);
-        break;
-
-    case PIECE_S:
-        list_add(piece->blocks, start_x, start_y, color);
-        list_add(piece->blocks, start_x + 1, start_y, color);
-        list_add(piece->blocks, start_x - 1, start_y + 1, color);
-        list_add(piece->blocks, start_x, start_y + 1, color);
-        break;
-
-    case PIECE_Z:
-        list_add(piece->blocks, start_x - 1, start_y, color);
-        list_add(piece->blocks, start_x, start_y, color);
-        list_add(piece->blocks, start_x, start_y + 1, color);
-        list_add(piece->blocks, start_x + 1, start_y + 1, color);
-        break;
-
-    case PIECE_J:
-        list_add(piece->blocks, start_x - 1, start_y, color);
-        list_add(piece->blocks, start_x - 1, start_y + 1, color);
-        list_add(piece->blocks, start_x, start_y + 1, color);
-        list_add(piece->blocks, start_x + 1, start_y + 1, color);
-        break;
-
-    case PIECE_L:
-        list_add(piece->blocks, start_x + 1, start_y, color);
-        list_add(piece->blocks, start_x - 1, start_y + 1, color);
-        list_add(piece->blocks, start_x, start_y + 1, color);
-        list_add(piece->blocks, start_x + 1, start_y + 1, color);
-        break;
-
-    default:
-        break;
-    }
+        {5, {{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}}},     // 0 -> L
+        {5, {{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}}},    // R -> 0
+        {5, {{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}}},  // 2 -> R
+        {5, {{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}}, // L -> 2
+    },
+};
+
+static const KickSet KICKS_I[2][4] = {
+    // Sens horaire
+    {
+        {5, {{0, 0}, {-2, 0}, {1, 0}, {-2, 1}, {1, -2}}}, // 0 -> R
+        {5, {{0, 0}, {-1, 0}, {2, 0}, {-1, -2}, {2, 1}}}, // R -> 2
+        {5, {{0, 0}, {2, 0}, {-1, 0}, {2, -1}, {-1, 2}}}, // 2 -> L
+        {5, {{0, 0}, {1, 0}, {-2, 0}, {1, 2}, {-2, -1}}}, // L -> 0
+    },
+    // Sens anti-horaire
+    {
+        {5, {{0, 0}, {-1, 0}, {2, 0}, {-1, -2}, {2, 1}}}, // 0 -> L
+        {5, {{0, 0}, {2, 0}, {-1, 0}, {2, -1}, {-1, 2}}}, // R -> 0
+        {5, {{0, 0}, {1, 0}, {-2, 0}, {1, 2}, {-2, -1}}}, // 2 -> R
+        {5, {{0, 0}, {-2, 0}, {1, 0}, {-2, 1}, {1, -2}}}, // L -> 2
+    },
+};
 
-    return piece;
-}
+static const KickSet KICKS_O = {1, {{0, 0}}};
 
 /*
- * Crée une pièce aléatoire
+ * Recopie dans la pièce les blocs de son état de rotation courant
  */
-Piece *piece_create_random(void)
+static void piece_load_shape(Piece *piece)
 {
-    static bool seeded = false;
-    if (!seeded)
+    for (int i = 0; i < PIECE_BLOCKS; i++)
     {
-        srand((unsigned int)time(NULL));
-        seeded = true;
+        piece->cells[i] = PIECE_SHAPES[piece->type][piece->rotation][i];
     }
-
-    PieceType type = (PieceType)(rand() % PIECE_COUNT);
-    return piece_create(type);
 }
 
 /*
- * Détruit une pièce
+ * Initialise une pièce selon son type
+ *
+ * La boîte de rotation est centrée en haut de la grille (colonnes 3 à 5
+ * ou 3 à 6), les blocs de l'état 0 apparaissent sur les lignes 0 et 1.
  */
-void piece_destroy(Piece *piece)
+void piece_init(Piece *piece, PieceType type)
 {
     if (piece == NULL)
         return;
 
-    if (piece->blocks != NULL)
-    {
-        list_destroy(piece->blocks);
-    }
+    if (type < 0 || type >= PIECE_COUNT)
+        type = PIECE_O;
 
-    free(piece);
+    piece->type = type;
+    piece->rotation = 0;
+    piece->color = piece_get_color(type);
+    piece->x = 3;
+    piece->y = (type == PIECE_I) ? -1 : 0; // L'état 0 du I est sur sa 2e ligne
+    piece_load_shape(piece);
 }
 
 /*
- * Déplace une pièce
+ * Prépare un sac vide
  */
-void piece_move(Piece *piece, int dx, int dy)
+void piece_bag_init(PieceBag *bag, uint64_t seed)
 {
-    if (piece == NULL || piece->blocks == NULL)
+    if (bag == NULL)
         return;
 
-    Block *current = piece->blocks->head;
-    while (current != NULL)
-    {
-        current->x += dx;
-        current->y += dy;
-        current = current->next;
-    }
+    rng_seed(&bag->rng, seed);
+    bag->remaining = 0;
 }
 
 /*
- * Calcule le centre de rotation
+ * Vide le sac
  */
-void piece_get_center(Piece *piece, float *center_x, float *center_y)
+void piece_bag_reset(PieceBag *bag)
 {
-    if (piece == NULL || piece->blocks == NULL)
-    {
-        *center_x = 0;
-        *center_y = 0;
+    if (bag == NULL)
         return;
-    }
 
-    float sum_x = 0, sum_y = 0;
-    int count = 0;
+    bag->remaining = 0;
+}
 
-    Block *current = piece->blocks->head;
-    while (current != NULL)
+/*
+ * Tire le prochain type du sac
+ */
+PieceType piece_bag_next(PieceBag *bag)
+{
+    if (bag == NULL)
+        return PIECE_I;
+
+    if (bag->remaining == 0)
     {
-        sum_x += current->x;
-        sum_y += current->y;
-        count++;
-        current = current->next;
+        // Nouveau sac: les 7 types, mélangés (Fisher-Yates)
+        for (int i = 0; i < PIECE_COUNT; i++)
+        {
+            bag->order[i] = (uint8_t)i;
+        }
+        for (int i = PIECE_COUNT - 1; i > 0; i--)
+        {
+            int j = (int)rng_below(&bag->rng, (uint32_t)(i + 1));
+            uint8_t swap = bag->order[i];
+            bag->order[i] = bag->order[j];
+            bag->order[j] = swap;
+        }
+        bag->remaining = PIECE_COUNT;
     }
 
-    *center_x = sum_x / count;
-    *center_y = sum_y / count;
+    bag->remaining--;
+    return (PieceType)bag->order[bag->remaining];
 }
 
 /*
- * Fait tourner la pièce de 90° dans le sens horaire
+ * Initialise une pièce tirée dans le sac
  */
-void piece_rotate(Piece *piece)
+void piece_init_random(Piece *piece, PieceBag *bag)
 {
-    if (piece == NULL || piece->blocks == NULL)
-        return;
-
-    if (piece->type == PIECE_O)
+    if (bag == NULL)
         return;
 
-    float cx, cy;
-    piece_get_center(piece, &cx, &cy);
-
-    Block *current = piece->blocks->head;
-    while (current != NULL)
-    {
-        int old_x = current->x;
-        int old_y = current->y;
-
-        current->x = (int)(cx - (old_y - cy));
-        current->y = (int)(cy + (old_x - cx));
+    piece_init(piece, piece_bag_next(bag));
+}
 
-        current = current->next;
-    }
+/*
+ * Déplace une pièce
+ */
+void piece_move(Piece *piece, int dx, int dy)
+{
+    if (piece == NULL)
+        return;
 
-    piece->rotation = (piece->rotation + 1) % 4;
+    piece->x += dx;
+    piece->y += dy;
 }
 
 /*
- * Copie une pièce
+ * Fait tourner la pièce sur place
  */
-Piece *piece_copy(Piece *piece)
+void piece_rotate(Piece *piece, RotationDirection direction)
 {
     if (piece == NULL)
-        return NULL;
-
-    Piece *copy = (Piece *)malloc(sizeof(Piece));
-    if (copy == NULL)
-        return NULL;
+        return;
 
-    copy->type = piece->type;
-    copy->rotation = piece->rotation;
-    copy->blocks = list_copy(piece->blocks);
+    piece->rotation = (piece->rotation + direction) & 3;
+    piece_load_shape(piece);
+}
 
-    if (copy->blocks == NULL)
-    {
-        free(copy);
-        return NULL;
-    }
+/*
+ * Retourne la forme d'un type dans un état de rotation
+ */
+const PieceCell *piece_get_shape(PieceType type, int rotation)
+{
+    return PIECE_SHAPES[type][rotation & 3];
+}
 
-    return copy;
-}
\ No newline at end of file
+/*
+ * Retourne les décalages de wall kick à essayer
+ */
+const PieceCell *piece_get_kicks(PieceType type, int from,
+                                 RotationDirection direction, int *count)
+{
+    const KickSet *set;
+
+    if (type == PIECE_O)
+        set = &KICKS_O;
+    else if (direction == ROTATE_180)
+        set = &KICKS_180[from & 3];
+    else if (type == PIECE_I)
+        set = &KICKS_I[direction == ROTATE_CW ? 0 : 1][from & 3];
+    else
+        set = &KICKS_JLSTZ[direction == ROTATE_CW ? 0 : 1][from & 3];
+
+    *count = set->count;
+    return set->offsets;
+}
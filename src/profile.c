@@ -0,0 +1,141 @@
+/*
+ * profile.c - Histogrammes de durée des phases de la boucle
+ *
+ * Sans TETRIS_PROFILE, seuls les noms des phases restent.
+ */
+
+#include "include/profile.h"
+
+static const char *phase_names[PROFILE_PHASE_COUNT] = {
+    "events", "update", "background", "board",
+    "ui", "overlay", "present", "frame"};
+
+/*
+ * Nom court d'une phase
+ */
+const char *profile_phase_name(ProfilePhase phase)
+{
+    return phase_names[phase];
+}
+
+#ifdef TETRIS_PROFILE
+
+#include "include/log.h"
+
+static ProfileHistogram histograms[PROFILE_PHASE_COUNT];
+
+/*
+ * Tranche d'une durée: exacte sous PROFILE_SUB_COUNT, puis les
+ * PROFILE_SUB_BITS bits de tête de la valeur
+ */
+static int bucket_index(int us)
+{
+    if (us < PROFILE_SUB_COUNT)
+        return us;
+
+    int shift = 0;
+    while ((us >> shift) >= 2 * PROFILE_SUB_COUNT)
+    {
+        shift++;
+    }
+    return PROFILE_SUB_COUNT * (shift + 1) + (us >> shift) - PROFILE_SUB_COUNT;
+}
+
+/*
+ * Plus grande durée rangée dans une tranche
+ */
+static int bucket_high(int bucket)
+{
+    if (bucket < PROFILE_SUB_COUNT)
+        return bucket;
+
+    int shift = bucket / PROFILE_SUB_COUNT - 1;
+    int lead = PROFILE_SUB_COUNT + bucket % PROFILE_SUB_COUNT;
+    return ((lead + 1) << shift) - 1;
+}
+
+/*
+ * Durée sous laquelle tombent au moins `percent` % des mesures
+ */
+static int percentile(const int *buckets, int count, int max, int percent)
+{
+    // Rang de la mesure cherchée (arrondi au-dessus)
+    long long rank = ((long long)count * percent + 99) / 100;
+    long long seen = 0;
+
+    for (int b = 0; b < PROFILE_BUCKETS; b++)
+    {
+        seen += buckets[b];
+        if (seen >= rank)
+        {
+            int high = bucket_high(b);
+            return high < max ? high : max;
+        }
+    }
+    return max;
+}
+
+/*
+ * Démarre la mesure d'une phase
+ */
+void profile_begin(ProfilePhase phase)
+{
+    histograms[phase].start = SDL_GetPerformanceCounter();
+}
+
+/*
+ * Termine la mesure d'une phase
+ */
+void profile_end(ProfilePhase phase)
+{
+    ProfileHistogram *h = &histograms[phase];
+    Uint64 elapsed = SDL_GetPerformanceCounter() - h->start;
+    Uint64 us = elapsed * 1000000 / SDL_GetPerformanceFrequency();
+    int value = (us > PROFILE_MAX_US) ? PROFILE_MAX_US : (int)us;
+
+    SDL_AtomicAdd(&h->buckets[bucket_index(value)], 1);
+
+    int max = SDL_AtomicGet(&h->max);
+    while (value > max && !SDL_AtomicCAS(&h->max, max, value))
+    {
+        max = SDL_AtomicGet(&h->max);
+    }
+}
+
+/*
+ * Affiche le résumé de chaque phase
+ */
+void profile_dump(void)
+{
+    static int buckets[PROFILE_BUCKETS];
+
+    log_write(LOG_INFO, "\n=== PROFIL (µs) ===\n");
+    log_write(LOG_INFO, "%-12s %10s %8s %8s %8s\n", "phase", "mesures", "p50", "p99", "max");
+
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++)
+    {
+        ProfileHistogram *h = &histograms[p];
+        int count = 0;
+
+        // Copie des compteurs: l'histogramme peut avancer pendant la
+        // lecture, les percentiles restent cohérents avec la copie
+        for (int b = 0; b < PROFILE_BUCKETS; b++)
+        {
+            buckets[b] = SDL_AtomicGet(&h->buckets[b]);
+            count += buckets[b];
+        }
+        int max = SDL_AtomicGet(&h->max);
+
+        if (count == 0)
+        {
+            log_write(LOG_INFO, "%-12s %10d %8s %8s %8s\n", phase_names[p], 0, "-", "-", "-");
+            continue;
+        }
+
+        log_write(LOG_INFO, "%-12s %10d %8d %8d %8d\n", phase_names[p], count,
+                  percentile(buckets, count, max, 50),
+                  percentile(buckets, count, max, 99), max);
+    }
+}
+
+#endif /* TETRIS_PROFILE */
@@ -3,15 +3,382 @@
  */
 
 #include "include/render.h"
+#include "include/alloc.h"
+#include "include/log.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/*
+ * Ajoute un quad texturé au lot (coordonnées de texture en pixels de
+ * l'atlas des sprites)
+ */
+static void batch_push_quad(Renderer *renderer, int x, int y, int w, int h,
+                            SDL_Color color, SDL_FRect uv)
+{
+    if (renderer->batch_quads == RENDER_BATCH_QUADS)
+    {
+        render_flush(renderer);
+    }
+
+    SDL_Vertex *v = &renderer->batch_vertices[renderer->batch_quads * 4];
+    float x0 = (float)x, y0 = (float)y;
+    float x1 = (float)(x + w), y1 = (float)(y + h);
+    float u0 = uv.x * renderer->sprites_inv_w, v0 = uv.y * renderer->sprites_inv_h;
+    float u1 = (uv.x + uv.w) * renderer->sprites_inv_w;
+    float v1 = (uv.y + uv.h) * renderer->sprites_inv_h;
+
+    v[0] = (SDL_Vertex){{x0, y0}, color, {u0, v0}};
+    v[1] = (SDL_Vertex){{x1, y0}, color, {u1, v0}};
+    v[2] = (SDL_Vertex){{x1, y1}, color, {u1, v1}};
+    v[3] = (SDL_Vertex){{x0, y1}, color, {u0, v1}};
+
+    renderer->batch_quads++;
+}
+
+/*
+ * Ajoute un rectangle plein au lot (un quad, couleur par sommet)
+ *
+ * Le quad échantillonne le texel blanc de l'atlas: rectangles et sprites
+ * partagent la même texture, donc le même appel de dessin.
+ */
+static void batch_push_rect(Renderer *renderer, int x, int y, int w, int h,
+                            SDL_Color color)
+{
+    SDL_FRect uv = {renderer->white_uv.x, renderer->white_uv.y, 0.0f, 0.0f};
+    batch_push_quad(renderer, x, y, w, h, color, uv);
+}
+
+/*
+ * Ajoute le contour d'un rectangle (1 pixel) au lot: 4 quads fins
+ */
+static void batch_push_outline(Renderer *renderer, int x, int y, int w, int h,
+                               SDL_Color color)
+{
+    batch_push_rect(renderer, x, y, w, 1, color);                 // Haut
+    batch_push_rect(renderer, x, y + h - 1, w, 1, color);         // Bas
+    batch_push_rect(renderer, x, y + 1, 1, h - 2, color);         // Gauche
+    batch_push_rect(renderer, x + w - 1, y + 1, 1, h - 2, color); // Droite
+}
+
+/*
+ * Ajoute une valeur à une composante de couleur, bornée à 0..255
+ */
+static Uint8 channel_add(Uint8 value, int delta)
+{
+    int v = value + delta;
+    return (Uint8)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+/*
+ * Index du sprite d'une couleur de la palette des pièces
+ *
+ * Retour: Type de pièce de même couleur, -1 si la couleur n'en est pas une
+ */
+static int sprite_for_color(const Renderer *renderer, Color color)
+{
+    for (int i = 0; i < PIECE_COUNT; i++)
+    {
+        Color c = renderer->sprite_colors[i];
+        if (c.r == color.r && c.g == color.g && c.b == color.b && c.a == color.a)
+            return i;
+    }
+    return -1;
+}
+
+/*
+ * Ajoute un sprite de l'atlas au lot, coin haut gauche de la case en pixels
+ */
+static void batch_push_sprite(Renderer *renderer, int px, int py, int sprite, bool ghost)
+{
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_FRect uv = {(float)(sprite * SPRITE_SIZE), (float)(ghost ? SPRITE_SIZE : 0),
+                    (float)SPRITE_SIZE, (float)SPRITE_SIZE};
+    batch_push_quad(renderer, px + 1, py + 1, SPRITE_SIZE, SPRITE_SIZE, white, uv);
+}
+
+/*
+ * Ajoute un bloc au lot, coin haut gauche de la case en pixels
+ *
+ * Sprite en relief de l'atlas si la couleur est celle d'une pièce;
+ * sinon (ou sans atlas) effet 3D simple: quad éclairci recouvert par
+ * l'intérieur décalé d'un pixel
+ */
+static void batch_push_block(Renderer *renderer, int px, int py, Color color)
+{
+    int sprite = renderer->sprites != NULL ? sprite_for_color(renderer, color) : -1;
+    if (sprite >= 0)
+    {
+        batch_push_sprite(renderer, px, py, sprite, false);
+        return;
+    }
+
+    SDL_Color light = {channel_add(color.r, 40), channel_add(color.g, 40),
+                       channel_add(color.b, 40), 255};
+    SDL_Color fill = {color.r, color.g, color.b, color.a};
+    batch_push_rect(renderer, px + 1, py + 1, BLOCK_SIZE - 2, BLOCK_SIZE - 2, light);
+    batch_push_rect(renderer, px + 2, py + 2, BLOCK_SIZE - 4, BLOCK_SIZE - 4, fill);
+}
+
+/*
+ * Ajoute une case de la pièce fantôme au lot (contour transparent)
+ */
+static void batch_push_ghost(Renderer *renderer, int px, int py, Color color)
+{
+    int sprite = renderer->sprites != NULL ? sprite_for_color(renderer, color) : -1;
+    if (sprite >= 0)
+    {
+        batch_push_sprite(renderer, px, py, sprite, true);
+        return;
+    }
+
+    SDL_Color outline = {color.r, color.g, color.b, 100};
+    batch_push_outline(renderer, px + 2, py + 2,
+                       BLOCK_SIZE - 4, BLOCK_SIZE - 4, outline);
+}
+
+/*
+ * Construit l'atlas des sprites: un bloc en relief par couleur de pièce
+ * (première rangée), sa variante fantôme (deuxième rangée), et un carré
+ * blanc pour les rectangles pleins
+ *
+ * Retour: false si l'atlas n'a pas pu être créé (les blocs sont alors
+ * dessinés avec des rectangles)
+ */
+static bool sprites_build(Renderer *renderer)
+{
+    const int width = PIECE_COUNT * SPRITE_SIZE + 4;
+    const int height = 2 * SPRITE_SIZE;
+    const int bevel = 2;
+
+    SDL_Surface *sheet = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32,
+                                                        SDL_PIXELFORMAT_RGBA32);
+    if (sheet == NULL)
+        return false;
+
+    Uint32 *pixels = (Uint32 *)sheet->pixels;
+    int stride = sheet->pitch / (int)sizeof(Uint32);
+
+    for (int t = 0; t < PIECE_COUNT; t++)
+    {
+        Color c = piece_get_color((PieceType)t);
+        renderer->sprite_colors[t] = c;
+
+        Uint32 fill = SDL_MapRGBA(sheet->format, c.r, c.g, c.b, 255);
+        Uint32 light = SDL_MapRGBA(sheet->format, channel_add(c.r, 60),
+                                   channel_add(c.g, 60), channel_add(c.b, 60), 255);
+        Uint32 shade = SDL_MapRGBA(sheet->format, (Uint8)(c.r * 3 / 5),
+                                   (Uint8)(c.g * 3 / 5), (Uint8)(c.b * 3 / 5), 255);
+        Uint32 ghost = SDL_MapRGBA(sheet->format, c.r, c.g, c.b, 100);
+        Uint32 clear = SDL_MapRGBA(sheet->format, 0, 0, 0, 0);
+
+        for (int y = 0; y < SPRITE_SIZE; y++)
+        {
+            for (int x = 0; x < SPRITE_SIZE; x++)
+            {
+                // Bloc: bords haut/gauche éclairés, bas/droite ombrés
+                // (le bord le plus proche décide, coins en diagonale)
+                int top = y, left = x;
+                int bottom = SPRITE_SIZE - 1 - y, right = SPRITE_SIZE - 1 - x;
+                Uint32 block = fill;
+                if (top < bevel || left < bevel || bottom < bevel || right < bevel)
+                {
+                    bool lit = (top <= bottom && top <= right) ||
+                               (left <= bottom && left <= right);
+                    block = lit ? light : shade;
+                }
+
+                // Fantôme: contour d'un pixel, un pixel en retrait
+                bool edge = (x == 1 || y == 1 || x == SPRITE_SIZE - 2 || y == SPRITE_SIZE - 2) &&
+                            x >= 1 && y >= 1 && x <= SPRITE_SIZE - 2 && y <= SPRITE_SIZE - 2;
+
+                pixels[y * stride + t * SPRITE_SIZE + x] = block;
+                pixels[(y + SPRITE_SIZE) * stride + t * SPRITE_SIZE + x] = edge ? ghost : clear;
+            }
+        }
+    }
+
+    // Carré blanc (4x4): les rectangles pleins échantillonnent son centre
+    Uint32 white = SDL_MapRGBA(sheet->format, 255, 255, 255, 255);
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 4; x++)
+        {
+            pixels[y * stride + PIECE_COUNT * SPRITE_SIZE + x] = white;
+        }
+    }
+
+    renderer->sprites = SDL_CreateTextureFromSurface(renderer->renderer, sheet);
+    SDL_FreeSurface(sheet);
+    if (renderer->sprites == NULL)
+        return false;
+
+    SDL_SetTextureBlendMode(renderer->sprites, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(renderer->sprites, SDL_ScaleModeNearest);
+    renderer->white_uv = (SDL_FPoint){(float)(PIECE_COUNT * SPRITE_SIZE + 2), 2.0f};
+    renderer->sprites_inv_w = 1.0f / (float)width;
+    renderer->sprites_inv_h = 1.0f / (float)height;
+    return true;
+}
+
+/*
+ * Toutes les cases de la grille sont à repeindre
+ */
+static void board_mark_all_dirty(Renderer *renderer)
+{
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        renderer->board_dirty[y] = GRID_ROW_FULL;
+    }
+}
+
+/*
+ * Au moins une case à repeindre?
+ */
+static bool board_is_dirty(const Renderer *renderer)
+{
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        if (renderer->board_dirty[y] != 0)
+            return true;
+    }
+    return false;
+}
+
+/*
+ * Libère les textures de la grille (cible, texels, surimpression)
+ */
+static void board_destroy_textures(Renderer *renderer)
+{
+    if (renderer->board != NULL)
+    {
+        SDL_DestroyTexture(renderer->board);
+        renderer->board = NULL;
+    }
+    if (renderer->board_texels != NULL)
+    {
+        SDL_DestroyTexture(renderer->board_texels);
+        renderer->board_texels = NULL;
+    }
+    if (renderer->board_overlay != NULL)
+    {
+        SDL_DestroyTexture(renderer->board_overlay);
+        renderer->board_overlay = NULL;
+    }
+}
+
+/*
+ * Dessine le décor fixe sur la cible courante: fond, grille, cadres de
+ * l'UI et de la prochaine pièce
+ */
+static void draw_static_layout(Renderer *renderer)
+{
+    render_clear(renderer);
+    render_grid(renderer);
+
+    SDL_SetRenderDrawColor(renderer->renderer, 255, 255, 255, 255);
+
+    // Zones Score, Level, Lines
+    SDL_Rect score_frame = {50, 100, 150, 80};
+    SDL_Rect level_frame = {50, 200, 150, 80};
+    SDL_Rect lines_frame = {50, 300, 150, 80};
+    SDL_RenderDrawRect(renderer->renderer, &score_frame);
+    renderer->draw_calls++;
+    SDL_RenderDrawRect(renderer->renderer, &level_frame);
+    renderer->draw_calls++;
+    SDL_RenderDrawRect(renderer->renderer, &lines_frame);
+    renderer->draw_calls++;
+
+    // Prochaine pièce: titre "NEXT" et cadre (voir render_next_piece)
+    SDL_Rect title_rect = {550, 120, 80, 20};
+    SDL_Rect next_frame = {540, 140, 120, 120};
+    SDL_RenderDrawRect(renderer->renderer, &title_rect);
+    renderer->draw_calls++;
+    SDL_RenderDrawRect(renderer->renderer, &next_frame);
+    renderer->draw_calls++;
+}
+
+/*
+ * (Re)crée la texture du décor à la taille de la sortie et la redessine
+ *
+ * Retour: true si la texture est prête, false si les textures cibles
+ * ne sont pas disponibles (le décor est alors dessiné chaque frame)
+ */
+static bool background_rebuild(Renderer *renderer)
+{
+    int width, height;
+    if (SDL_GetRendererOutputSize(renderer->renderer, &width, &height) != 0)
+    {
+        width = WINDOW_WIDTH;
+        height = WINDOW_HEIGHT;
+    }
+
+    // Recréer la texture seulement si la taille a changé
+    if (renderer->background != NULL)
+    {
+        int tex_w, tex_h;
+        SDL_QueryTexture(renderer->background, NULL, NULL, &tex_w, &tex_h);
+        if (tex_w != width || tex_h != height)
+        {
+            SDL_DestroyTexture(renderer->background);
+            renderer->background = NULL;
+        }
+    }
+
+    if (renderer->background == NULL)
+    {
+        renderer->background = SDL_CreateTexture(renderer->renderer,
+                                                 SDL_PIXELFORMAT_ARGB8888,
+                                                 SDL_TEXTUREACCESS_TARGET,
+                                                 width, height);
+        if (renderer->background == NULL)
+        {
+            return false;
+        }
+    }
+
+    if (SDL_SetRenderTarget(renderer->renderer, renderer->background) != 0)
+    {
+        SDL_DestroyTexture(renderer->background);
+        renderer->background = NULL;
+        return false;
+    }
+
+    draw_static_layout(renderer);
+    SDL_SetRenderTarget(renderer->renderer, NULL);
+
+    renderer->background_dirty = false;
+    return true;
+}
+
+/*
+ * Ouvre une police système courante à la taille demandée
+ *
+ * Retour: NULL si aucune n'est disponible
+ */
+static TTF_Font *font_open(int size)
+{
+    // Essayons plusieurs polices courantes
+    static const char *paths[] = {
+        "C:/Windows/Fonts/arial.ttf",
+        "C:/Windows/Fonts/calibri.ttf",
+        "C:/Windows/Fonts/consola.ttf"};
+
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++)
+    {
+        TTF_Font *font = TTF_OpenFont(paths[i], size);
+        if (font != NULL)
+            return font;
+    }
+    return NULL;
+}
 
 /*
  * Initialise SDL et crée la fenêtre
  */
 Renderer *render_init(void)
 {
-    Renderer *renderer = (Renderer *)malloc(sizeof(Renderer));
+    Renderer *renderer = (Renderer *)alloc_malloc(sizeof(Renderer));
     if (renderer == NULL)
     {
         fprintf(stderr, "Erreur: Impossible d'allouer le renderer\n");
@@ -22,7 +389,7 @@ Renderer *render_init(void)
     if (SDL_Init(SDL_INIT_VIDEO) < 0)
     {
         fprintf(stderr, "Erreur SDL_Init: %s\n", SDL_GetError());
-        free(renderer);
+        alloc_free(renderer);
         return NULL;
     }
 
@@ -31,7 +398,7 @@ Renderer *render_init(void)
     {
         fprintf(stderr, "Erreur TTF_Init: %s\n", TTF_GetError());
         SDL_Quit();
-        free(renderer);
+        alloc_free(renderer);
         return NULL;
     }
 
@@ -49,7 +416,7 @@ Renderer *render_init(void)
         fprintf(stderr, "Erreur SDL_CreateWindow: %s\n", SDL_GetError());
         TTF_Quit();
         SDL_Quit();
-        free(renderer);
+        alloc_free(renderer);
         return NULL;
     }
 
@@ -57,7 +424,7 @@ Renderer *render_init(void)
     renderer->renderer = SDL_CreateRenderer(
         renderer->window,
         -1,
-        SDL_RENDERER_ACCELERATED);
+        SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
 
     if (renderer->renderer == NULL)
     {
@@ -65,39 +432,68 @@ Renderer *render_init(void)
         SDL_DestroyWindow(renderer->window);
         TTF_Quit();
         SDL_Quit();
-        free(renderer);
+        alloc_free(renderer);
         return NULL;
     }
 
     // ✅ Charger les polices (on utilise une police système Windows)
-    // Essayons plusieurs polices courantes
-    renderer->font = TTF_OpenFont("C:/Windows/Fonts/arial.ttf", 24);
-    if (renderer->font == NULL)
-    {
-        // Essayer une autre police
-        renderer->font = TTF_OpenFont("C:/Windows/Fonts/calibri.ttf", 24);
-    }
-    if (renderer->font == NULL)
+    renderer->font = font_open(24);
+    renderer->font_large = font_open(48);
+    renderer->font_small = font_open(14);
+
+    if (renderer->font == NULL || renderer->font_large == NULL)
     {
-        // Dernière tentative
-        renderer->font = TTF_OpenFont("C:/Windows/Fonts/consola.ttf", 24);
+        fprintf(stderr, "Avertissement: Impossible de charger les polices\n");
+        // On continue quand même
     }
 
-    renderer->font_large = TTF_OpenFont("C:/Windows/Fonts/arial.ttf", 48);
-    if (renderer->font_large == NULL)
+    // Lot de quads: les indices ne changent jamais (0-1-2, 0-2-3 par quad)
+    for (int q = 0; q < RENDER_BATCH_QUADS; q++)
     {
-        renderer->font_large = TTF_OpenFont("C:/Windows/Fonts/calibri.ttf", 48);
+        int *idx = &renderer->batch_indices[q * 6];
+        idx[0] = q * 4;
+        idx[1] = q * 4 + 1;
+        idx[2] = q * 4 + 2;
+        idx[3] = q * 4;
+        idx[4] = q * 4 + 2;
+        idx[5] = q * 4 + 3;
     }
-    if (renderer->font_large == NULL)
+    renderer->batch_quads = 0;
+
+    // Atlas des sprites (blocs en relief, fantômes, texel blanc)
+    renderer->sprites = NULL;
+    renderer->white_uv = (SDL_FPoint){0.0f, 0.0f};
+    renderer->sprites_inv_w = 0.0f;
+    renderer->sprites_inv_h = 0.0f;
+    if (!sprites_build(renderer))
     {
-        renderer->font_large = TTF_OpenFont("C:/Windows/Fonts/consola.ttf", 48);
+        fprintf(stderr, "Avertissement: Atlas des sprites indisponible\n");
     }
 
-    if (renderer->font == NULL || renderer->font_large == NULL)
-    {
-        fprintf(stderr, "Avertissement: Impossible de charger les polices\n");
-        // On continue quand même
-    }
+    // Cache de texte vide: atlas et chaînes créés au premier usage
+    text_cache_init(&renderer->text, renderer->renderer);
+
+    // Décor construit à la première frame
+    renderer->background = NULL;
+    renderer->background_dirty = true;
+
+    // Grille peinte entièrement à la première frame
+    renderer->board_mode = BOARD_MODE_TARGET;
+    renderer->board = NULL;
+    renderer->board_texels = NULL;
+    renderer->board_overlay = NULL;
+    renderer->board_overlay_dirty = false;
+    renderer->overlay_count = 0;
+    memset(renderer->board_rows, 0, sizeof(renderer->board_rows));
+    memset(renderer->board_colors, 0, sizeof(renderer->board_colors));
+    renderer->board_version = 0;
+    board_mark_all_dirty(renderer);
+
+    // Compteurs de dessin, perfs masquées
+    renderer->draw_calls = 0;
+    renderer->frame_draw_calls = 0;
+    renderer->show_hud = false;
+    renderer->perf = NULL;
 
     renderer->running = true;
 
@@ -124,6 +520,24 @@ void render_destroy(Renderer *renderer)
     {
         TTF_CloseFont(renderer->font_large);
     }
+    if (renderer->font_small != NULL)
+    {
+        TTF_CloseFont(renderer->font_small);
+    }
+
+    text_cache_destroy(&renderer->text);
+
+    board_destroy_textures(renderer);
+
+    if (renderer->sprites != NULL)
+    {
+        SDL_DestroyTexture(renderer->sprites);
+    }
+
+    if (renderer->background != NULL)
+    {
+        SDL_DestroyTexture(renderer->background);
+    }
 
     if (renderer->renderer != NULL)
     {
@@ -137,8 +551,19 @@ void render_destroy(Renderer *renderer)
 
     TTF_Quit(); // ✅ Ajouter
     SDL_Quit();
-    free(renderer);
+    alloc_free(renderer);
+}
+/*
+ * Active/désactive la synchronisation verticale
+ */
+bool render_set_vsync(Renderer *renderer, bool enabled)
+{
+    if (renderer == NULL)
+        return false;
+
+    return SDL_RenderSetVSync(renderer->renderer, enabled ? 1 : 0) == 0;
 }
+
 /*
  * Efface l'écran avec une couleur de fond
  */
@@ -150,6 +575,88 @@ void render_clear(Renderer *renderer)
     // Couleur de fond: noir
     SDL_SetRenderDrawColor(renderer->renderer, 20, 20, 30, 255);
     SDL_RenderClear(renderer->renderer);
+    renderer->draw_calls++;
+}
+
+/*
+ * Dessine le décor fixe: une seule copie de texture par frame
+ */
+void render_background(Renderer *renderer)
+{
+    if (renderer == NULL)
+        return;
+
+    if (renderer->background_dirty || renderer->background == NULL)
+    {
+        if (!background_rebuild(renderer))
+        {
+            // Pas de texture cible: dessin direct
+            draw_static_layout(renderer);
+            return;
+        }
+    }
+
+    SDL_RenderCopy(renderer->renderer, renderer->background, NULL, NULL);
+    renderer->draw_calls++;
+}
+
+/*
+ * Marque le décor à redessiner quand il peut être invalide
+ */
+void render_handle_event(Renderer *renderer, const SDL_Event *event)
+{
+    if (renderer == NULL || event == NULL)
+        return;
+
+    switch (event->type)
+    {
+    case SDL_WINDOWEVENT:
+        if (event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+        {
+            renderer->background_dirty = true;
+        }
+        break;
+
+    case SDL_RENDER_TARGETS_RESET:
+        // Contenu des textures cibles perdu (Direct3D), les textures
+        // restent: tout repeindre dedans, sans rien recréer (aucune
+        // allocation en jeu). La texture de streaming n'est pas une
+        // cible, ses texels sont renvoyés avec les cases marquées.
+        renderer->background_dirty = true;
+        renderer->board_overlay_dirty = true;
+        board_mark_all_dirty(renderer);
+        break;
+
+    case SDL_RENDER_DEVICE_RESET:
+        // Toutes les textures sont perdues: recréer
+        if (renderer->background != NULL)
+        {
+            SDL_DestroyTexture(renderer->background);
+            renderer->background = NULL;
+        }
+        board_destroy_textures(renderer);
+        board_mark_all_dirty(renderer);
+        renderer->background_dirty = true;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*
+ * Envoie le lot de quads en attente
+ */
+void render_flush(Renderer *renderer)
+{
+    if (renderer == NULL || renderer->batch_quads == 0)
+        return;
+
+    SDL_RenderGeometry(renderer->renderer, renderer->sprites,
+                       renderer->batch_vertices, renderer->batch_quads * 4,
+                       renderer->batch_indices, renderer->batch_quads * 6);
+    renderer->batch_quads = 0;
+    renderer->draw_calls++;
 }
 
 /*
@@ -159,6 +666,13 @@ void render_present(Renderer *renderer)
 {
     if (renderer == NULL)
         return;
+    render_flush(renderer);
+
+    // Bilan des appels de dessin de la frame
+    renderer->frame_draw_calls = renderer->draw_calls + renderer->text.draw_calls;
+    renderer->draw_calls = 0;
+    renderer->text.draw_calls = 0;
+
     SDL_RenderPresent(renderer->renderer);
 }
 
@@ -180,6 +694,7 @@ void render_grid(Renderer *renderer)
         SDL_RenderDrawLine(renderer->renderer, // ✅ SDL_RenderDrawLine
                            px, GRID_OFFSET_Y,
                            px, GRID_OFFSET_Y + GRID_HEIGHT * BLOCK_SIZE);
+        renderer->draw_calls++;
     }
 
     // Dessiner les lignes horizontales
@@ -189,6 +704,7 @@ void render_grid(Renderer *renderer)
         SDL_RenderDrawLine(renderer->renderer, // ✅ SDL_RenderDrawLine
                            GRID_OFFSET_X, py,
                            GRID_OFFSET_X + GRID_WIDTH * BLOCK_SIZE, py);
+        renderer->draw_calls++;
     }
 
     // Contour épais de la grille: blanc
@@ -199,12 +715,13 @@ void render_grid(Renderer *renderer)
                        GRID_WIDTH * BLOCK_SIZE + 4,
                        GRID_HEIGHT * BLOCK_SIZE + 4};
     SDL_RenderDrawRect(renderer->renderer, &border); // ✅ SDL_RenderDrawRect
+    renderer->draw_calls++;
 }
 
 /*
  * Dessine un bloc individuel
  */
-void render_block(Renderer *renderer, int x, int y, SDL_Color color)
+void render_block(Renderer *renderer, int x, int y, Color color)
 {
     if (renderer == NULL)
         return;
@@ -213,159 +730,614 @@ void render_block(Renderer *renderer, int x, int y, SDL_Color color)
     int px = GRID_OFFSET_X + x * BLOCK_SIZE;
     int py = GRID_OFFSET_Y + y * BLOCK_SIZE;
 
-    // Dessiner le bloc rempli
-    SDL_SetRenderDrawColor(renderer->renderer, color.r, color.g, color.b, color.a);
-    SDL_Rect rect = {px + 1, py + 1, BLOCK_SIZE - 2, BLOCK_SIZE - 2}; // ✅ SDL_Rect
-    SDL_RenderFillRect(renderer->renderer, &rect);
-
-    // Dessiner le contour (effet 3D simple)
-    SDL_SetRenderDrawColor(renderer->renderer,
-                           color.r + 40, color.g + 40, color.b + 40, 255);
-    SDL_RenderDrawRect(renderer->renderer, &rect); // ✅ SDL_RenderDrawRect
+    batch_push_block(renderer, px, py, color);
 }
 
 /*
  * Dessine une pièce
  */
-void render_piece(Renderer *renderer, Piece *piece)
+void render_piece(Renderer *renderer, const Piece *piece)
 {
-    if (renderer == NULL || piece == NULL || piece->blocks == NULL)
+    if (renderer == NULL || piece == NULL)
         return;
 
-    Block *current = piece->blocks->head;
-    while (current != NULL)
+    for (int i = 0; i < PIECE_BLOCKS; i++)
     {
+        int x = piece->x + piece->cells[i].x;
+        int y = piece->y + piece->cells[i].y;
+
         // Ne dessiner que les blocs visibles (y >= 0)
-        if (current->y >= 0)
+        if (y >= 0)
         {
-            render_block(renderer, current->x, current->y, current->color);
+            render_block(renderer, x, y, piece->color);
         }
-        current = current->next;
     }
 }
 
 /*
  * Dessine tous les blocs fixés
  */
-void render_fixed_blocks(Renderer *renderer, BlockList *blocks)
+void render_fixed_blocks(Renderer *renderer, const GameSnapshot *game)
 {
-    if (renderer == NULL || blocks == NULL)
+    if (renderer == NULL || game == NULL)
         return;
 
-    Block *current = blocks->head;
-    while (current != NULL)
+    for (int y = 0; y < GRID_HEIGHT; y++)
     {
-        render_block(renderer, current->x, current->y, current->color);
-        current = current->next;
+        GridRow row = game->grid_rows[y];
+        for (int x = 0; row != 0; x++, row >>= 1)
+        {
+            if (row & 1u)
+            {
+                render_block(renderer, x, y, game->grid_colors[y][x]);
+            }
+        }
     }
 }
 
 /*
  * Dessine la pièce fantôme (ghost piece)
  */
-void render_ghost_piece(Renderer *renderer, GameState *game)
+void render_ghost_piece(Renderer *renderer, const GameSnapshot *game)
 {
-    if (renderer == NULL || game == NULL || game->current_piece == NULL)
+    if (renderer == NULL || game == NULL)
         return;
 
-    // Créer une copie de la pièce
-    Piece *ghost = piece_copy(game->current_piece);
-    if (ghost == NULL)
-        return;
+    // Copier la pièce et la placer à sa position finale (distance calculée
+    // par la simulation)
+    Piece ghost = game->current_piece;
+    piece_move(&ghost, 0, game->ghost_distance);
 
-    // Descendre jusqu'à la position finale
-    while (!game_check_collision(ghost, game->fixed_blocks, 0, 1))
+    // Dessiner avec transparence
+    for (int i = 0; i < PIECE_BLOCKS; i++)
     {
-        piece_move(ghost, 0, 1);
+        int x = ghost.x + ghost.cells[i].x;
+        int y = ghost.y + ghost.cells[i].y;
+
+        if (y >= 0)
+        {
+            batch_push_ghost(renderer,
+                             GRID_OFFSET_X + x * BLOCK_SIZE,
+                             GRID_OFFSET_Y + y * BLOCK_SIZE,
+                             ghost.color);
+        }
     }
+}
 
-    // Dessiner avec transparence
-    Block *current = ghost->blocks->head;
-    while (current != NULL)
+/*
+ * Cases de la pièce courante et de son fantôme visibles dans la grille
+ *
+ * Retour: Nombre de cases écrites dans cells (au plus 2 * PIECE_BLOCKS)
+ */
+static int overlay_collect(const GameSnapshot *game, OverlayCell *cells)
+{
+    int count = 0;
+
+    if (game->game_over)
+        return 0;
+
+    const Piece *piece = &game->current_piece;
+
+    // Fantôme: masqué pendant la pause
+    if (!game->paused)
+    {
+        int distance = game->ghost_distance;
+        for (int i = 0; i < PIECE_BLOCKS; i++)
+        {
+            int x = piece->x + piece->cells[i].x;
+            int y = piece->y + piece->cells[i].y + distance;
+            if (y >= 0 && y < GRID_HEIGHT)
+            {
+                cells[count++] = (OverlayCell){x, y, true};
+            }
+        }
+    }
+
+    for (int i = 0; i < PIECE_BLOCKS; i++)
+    {
+        int x = piece->x + piece->cells[i].x;
+        int y = piece->y + piece->cells[i].y;
+        if (y >= 0 && y < GRID_HEIGHT)
+        {
+            cells[count++] = (OverlayCell){x, y, false};
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Marque des cases de la pièce ou du fantôme à repeindre
+ */
+static void overlay_mark_dirty(Renderer *renderer, const OverlayCell *cells, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        renderer->board_dirty[cells[i].y] |= (GridRow)1 << cells[i].x;
+    }
+}
+
+/*
+ * Repeint une case de la grille dans la texture (coordonnées locales):
+ * fond, lignes de la grille, puis bloc fixé, pièce ou fantôme
+ */
+static void board_paint_cell(Renderer *renderer, const GameSnapshot *game,
+                             GridRow piece_row, GridRow ghost_row, int x, int y)
+{
+    static const SDL_Color background = {20, 20, 30, 255};
+    static const SDL_Color grid_line = {60, 60, 70, 255};
+    GridRow bit = (GridRow)1 << x;
+    int px = x * BLOCK_SIZE;
+    int py = y * BLOCK_SIZE;
+
+    batch_push_rect(renderer, px, py, BLOCK_SIZE + 1, BLOCK_SIZE + 1, background);
+    batch_push_outline(renderer, px, py, BLOCK_SIZE + 1, BLOCK_SIZE + 1, grid_line);
+
+    if (game->grid_rows[y] & bit)
+    {
+        batch_push_block(renderer, px, py, game->grid_colors[y][x]);
+    }
+    else if (piece_row & bit)
+    {
+        batch_push_block(renderer, px, py, game->current_piece.color);
+    }
+    else if (ghost_row & bit)
+    {
+        batch_push_ghost(renderer, px, py, game->current_piece.color);
+    }
+}
+
+/*
+ * Dessine le contenu de la grille sans texture intermédiaire
+ */
+static void board_draw_direct(Renderer *renderer, const GameSnapshot *game)
+{
+    render_fixed_blocks(renderer, game);
+
+    if (!game->game_over && !game->paused)
+    {
+        render_ghost_piece(renderer, game);
+    }
+    if (!game->game_over)
+    {
+        render_piece(renderer, &game->current_piece);
+    }
+}
+
+/*
+ * Mode texture cible: repeint les cases modifiées dans la texture de la
+ * grille puis la recopie
+ *
+ * Retour: false si la texture cible n'est pas disponible
+ */
+static bool board_draw_target(Renderer *renderer, const GameSnapshot *game,
+                              const GridRow *piece_rows, const GridRow *ghost_rows)
+{
+    // Texture de la grille: créée au premier appel, entièrement à peindre
+    if (renderer->board == NULL)
+    {
+        renderer->board = SDL_CreateTexture(renderer->renderer,
+                                            SDL_PIXELFORMAT_ARGB8888,
+                                            SDL_TEXTUREACCESS_TARGET,
+                                            GRID_WIDTH * BLOCK_SIZE + 1,
+                                            GRID_HEIGHT * BLOCK_SIZE + 1);
+        if (renderer->board == NULL)
+            return false;
+
+        SDL_SetTextureBlendMode(renderer->board, SDL_BLENDMODE_NONE);
+        board_mark_all_dirty(renderer);
+    }
+
+    if (board_is_dirty(renderer))
+    {
+        if (SDL_SetRenderTarget(renderer->renderer, renderer->board) != 0)
+        {
+            SDL_DestroyTexture(renderer->board);
+            renderer->board = NULL;
+            return false;
+        }
+
+        for (int y = 0; y < GRID_HEIGHT; y++)
+        {
+            GridRow row = renderer->board_dirty[y];
+            for (int x = 0; row != 0; x++, row >>= 1)
+            {
+                if (row & 1u)
+                {
+                    board_paint_cell(renderer, game, piece_rows[y], ghost_rows[y], x, y);
+                }
+            }
+            renderer->board_dirty[y] = 0;
+        }
+
+        render_flush(renderer);
+        SDL_SetRenderTarget(renderer->renderer, NULL);
+    }
+
+    SDL_Rect dest = {GRID_OFFSET_X, GRID_OFFSET_Y,
+                     GRID_WIDTH * BLOCK_SIZE + 1, GRID_HEIGHT * BLOCK_SIZE + 1};
+    SDL_RenderCopy(renderer->renderer, renderer->board, NULL, &dest);
+    renderer->draw_calls++;
+    return true;
+}
+
+/*
+ * Couleur d'un texel (ARGB8888) en mode texture de streaming
+ *
+ * Le fantôme, qui n'a pas de contour à cette échelle, est une version
+ * assombrie de la couleur de la pièce.
+ */
+static Uint32 board_texel(const GameSnapshot *game, GridRow piece_row, GridRow ghost_row,
+                          int x, int y)
+{
+    GridRow bit = (GridRow)1 << x;
+    Color c = {20, 20, 30, 255}; // Fond
+
+    if (game->grid_rows[y] & bit)
+    {
+        c = game->grid_colors[y][x];
+    }
+    else if (piece_row & bit)
+    {
+        c = game->current_piece.color;
+    }
+    else if (ghost_row & bit)
+    {
+        Color p = game->current_piece.color;
+        c.r = (Uint8)((p.r * 100 + c.r * 155) / 255);
+        c.g = (Uint8)((p.g * 100 + c.g * 155) / 255);
+        c.b = (Uint8)((p.b * 100 + c.b * 155) / 255);
+    }
+
+    return 0xFF000000u | ((Uint32)c.r << 16) | ((Uint32)c.g << 8) | c.b;
+}
+
+/*
+ * Peint les reliefs et la grille (identiques pour toutes les cases)
+ * dans la texture de surimpression existante
+ *
+ * Retour: false si la texture ne peut pas devenir la cible
+ */
+static bool board_paint_overlay(Renderer *renderer)
+{
+    static const SDL_Color light = {255, 255, 255, 50};
+    static const SDL_Color shade = {0, 0, 0, 70};
+    static const SDL_Color grid_line = {60, 60, 70, 255};
+    int width = GRID_WIDTH * BLOCK_SIZE + 1;
+    int height = GRID_HEIGHT * BLOCK_SIZE + 1;
+
+    if (SDL_SetRenderTarget(renderer->renderer, renderer->board_overlay) != 0)
+        return false;
+
+    // Écrire les texels tels quels (alpha compris): le mélange se fait
+    // à la recopie
+    SDL_BlendMode previous;
+    SDL_GetRenderDrawBlendMode(renderer->renderer, &previous);
+    SDL_SetRenderDrawBlendMode(renderer->renderer, SDL_BLENDMODE_NONE);
+    if (renderer->sprites != NULL)
+    {
+        SDL_SetTextureBlendMode(renderer->sprites, SDL_BLENDMODE_NONE);
+    }
+    SDL_SetRenderDrawColor(renderer->renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer->renderer);
+    renderer->draw_calls++;
+
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int x = 0; x < GRID_WIDTH; x++)
+        {
+            int px = x * BLOCK_SIZE;
+            int py = y * BLOCK_SIZE;
+
+            // Relief: bords haut/gauche éclairés, bas/droite ombrés
+            batch_push_rect(renderer, px + 1, py + 1, BLOCK_SIZE - 1, 2, light);
+            batch_push_rect(renderer, px + 1, py + 3, 2, BLOCK_SIZE - 3, light);
+            batch_push_rect(renderer, px + 3, py + BLOCK_SIZE - 2, BLOCK_SIZE - 3, 2, shade);
+            batch_push_rect(renderer, px + BLOCK_SIZE - 2, py + 3, 2, BLOCK_SIZE - 5, shade);
+        }
+    }
+
+    // Lignes de la grille
+    for (int x = 0; x <= GRID_WIDTH; x++)
+    {
+        batch_push_rect(renderer, x * BLOCK_SIZE, 0, 1, height, grid_line);
+    }
+    for (int y = 0; y <= GRID_HEIGHT; y++)
+    {
+        batch_push_rect(renderer, 0, y * BLOCK_SIZE, width, 1, grid_line);
+    }
+
+    render_flush(renderer);
+    if (renderer->sprites != NULL)
+    {
+        SDL_SetTextureBlendMode(renderer->sprites, SDL_BLENDMODE_BLEND);
+    }
+    SDL_SetRenderDrawBlendMode(renderer->renderer, previous);
+    SDL_SetRenderTarget(renderer->renderer, NULL);
+    renderer->board_overlay_dirty = false;
+    return true;
+}
+
+/*
+ * Crée la texture de surimpression du mode streaming et la peint
+ *
+ * Retour: false si les textures cibles ne sont pas disponibles
+ */
+static bool board_bake_overlay(Renderer *renderer)
+{
+    renderer->board_overlay = SDL_CreateTexture(renderer->renderer,
+                                                SDL_PIXELFORMAT_ARGB8888,
+                                                SDL_TEXTUREACCESS_TARGET,
+                                                GRID_WIDTH * BLOCK_SIZE + 1,
+                                                GRID_HEIGHT * BLOCK_SIZE + 1);
+    if (renderer->board_overlay == NULL)
+        return false;
+
+    SDL_SetTextureBlendMode(renderer->board_overlay, SDL_BLENDMODE_BLEND);
+    if (!board_paint_overlay(renderer))
+    {
+        SDL_DestroyTexture(renderer->board_overlay);
+        renderer->board_overlay = NULL;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Mode texture de streaming: un texel par case, envoyé par
+ * SDL_UpdateTexture seulement si une case a changé, puis agrandi en une
+ * copie et recouvert par la surimpression (relief et grille)
+ *
+ * Le coût par frame ne dépend pas du nombre de cases.
+ *
+ * Retour: false si la texture de streaming n'est pas disponible
+ */
+static bool board_draw_streaming(Renderer *renderer, const GameSnapshot *game,
+                                 const GridRow *piece_rows, const GridRow *ghost_rows)
+{
+    if (renderer->board_texels == NULL)
     {
-        if (current->y >= 0)
+        renderer->board_texels = SDL_CreateTexture(renderer->renderer,
+                                                   SDL_PIXELFORMAT_ARGB8888,
+                                                   SDL_TEXTUREACCESS_STREAMING,
+                                                   GRID_WIDTH, GRID_HEIGHT);
+        if (renderer->board_texels == NULL)
+            return false;
+
+        // Agrandissement sans filtrage: des cases nettes
+        SDL_SetTextureScaleMode(renderer->board_texels, SDL_ScaleModeNearest);
+        SDL_SetTextureBlendMode(renderer->board_texels, SDL_BLENDMODE_NONE);
+        board_mark_all_dirty(renderer);
+
+        // Sans surimpression, les lignes de la grille restent celles du décor
+        if (renderer->board_overlay == NULL)
         {
-            int px = GRID_OFFSET_X + current->x * BLOCK_SIZE;
-            int py = GRID_OFFSET_Y + current->y * BLOCK_SIZE;
-
-            // Contour transparent
-            SDL_SetRenderDrawColor(renderer->renderer,
-                                   current->color.r,
-                                   current->color.g,
-                                   current->color.b,
-                                   100);
-            SDL_Rect rect = {px + 2, py + 2, BLOCK_SIZE - 4, BLOCK_SIZE - 4}; // ✅ SDL_Rect
-            SDL_RenderDrawRect(renderer->renderer, &rect);                    // ✅ SDL_RenderDrawRect
+            board_bake_overlay(renderer);
         }
-        current = current->next;
     }
 
-    piece_destroy(ghost);
+    // Cibles de rendu perdues: repeindre la surimpression sur place
+    if (renderer->board_overlay_dirty && renderer->board_overlay != NULL)
+    {
+        board_paint_overlay(renderer);
+    }
+
+    if (board_is_dirty(renderer))
+    {
+        for (int y = 0; y < GRID_HEIGHT; y++)
+        {
+            GridRow row = renderer->board_dirty[y];
+            for (int x = 0; row != 0; x++, row >>= 1)
+            {
+                if (row & 1u)
+                {
+                    renderer->board_pixels[y][x] =
+                        board_texel(game, piece_rows[y], ghost_rows[y], x, y);
+                }
+            }
+            renderer->board_dirty[y] = 0;
+        }
+
+        SDL_UpdateTexture(renderer->board_texels, NULL, renderer->board_pixels,
+                          GRID_WIDTH * (int)sizeof(Uint32));
+    }
+
+    SDL_Rect cells = {GRID_OFFSET_X, GRID_OFFSET_Y,
+                      GRID_WIDTH * BLOCK_SIZE, GRID_HEIGHT * BLOCK_SIZE};
+    SDL_RenderCopy(renderer->renderer, renderer->board_texels, NULL, &cells);
+    renderer->draw_calls++;
+
+    if (renderer->board_overlay != NULL)
+    {
+        SDL_Rect dest = {GRID_OFFSET_X, GRID_OFFSET_Y,
+                         GRID_WIDTH * BLOCK_SIZE + 1, GRID_HEIGHT * BLOCK_SIZE + 1};
+        SDL_RenderCopy(renderer->renderer, renderer->board_overlay, NULL, &dest);
+        renderer->draw_calls++;
+    }
+    return true;
+}
+
+/*
+ * Dessine la grille: met à jour les cases modifiées puis compose
+ */
+void render_board(Renderer *renderer, const GameSnapshot *game)
+{
+    if (renderer == NULL || game == NULL)
+        return;
+
+    // Grille modifiée depuis le dernier instantané peint (fixation,
+    // lignes, remise à zéro): comparer case par case avec sa copie
+    if (game->grid_version != renderer->board_version)
+    {
+        for (int y = 0; y < GRID_HEIGHT; y++)
+        {
+            GridRow changed = game->grid_rows[y] ^ renderer->board_rows[y];
+            for (int x = 0; x < GRID_WIDTH; x++)
+            {
+                Color a = game->grid_colors[y][x];
+                Color b = renderer->board_colors[y][x];
+                if (a.r != b.r || a.g != b.g || a.b != b.b || a.a != b.a)
+                {
+                    changed |= (GridRow)1 << x;
+                }
+            }
+            renderer->board_dirty[y] |= changed;
+        }
+        memcpy(renderer->board_rows, game->grid_rows, sizeof(renderer->board_rows));
+        memcpy(renderer->board_colors, game->grid_colors, sizeof(renderer->board_colors));
+        renderer->board_version = game->grid_version;
+    }
+
+    // Pièce et fantôme: si leurs cases ont changé, repeindre les
+    // anciennes et les nouvelles
+    OverlayCell overlay[PIECE_BLOCKS * 2];
+    int overlay_count = overlay_collect(game, overlay);
+    bool moved = overlay_count != renderer->overlay_count;
+    for (int i = 0; i < overlay_count && !moved; i++)
+    {
+        moved = overlay[i].x != renderer->overlay[i].x ||
+                overlay[i].y != renderer->overlay[i].y ||
+                overlay[i].ghost != renderer->overlay[i].ghost;
+    }
+    if (moved)
+    {
+        overlay_mark_dirty(renderer, renderer->overlay, renderer->overlay_count);
+        overlay_mark_dirty(renderer, overlay, overlay_count);
+        memcpy(renderer->overlay, overlay, sizeof(overlay));
+        renderer->overlay_count = overlay_count;
+    }
+
+    // Masques de la pièce et du fantôme, ligne par ligne
+    GridRow piece_rows[GRID_HEIGHT] = {0};
+    GridRow ghost_rows[GRID_HEIGHT] = {0};
+    for (int i = 0; i < overlay_count; i++)
+    {
+        GridRow bit = (GridRow)1 << overlay[i].x;
+        if (overlay[i].ghost)
+            ghost_rows[overlay[i].y] |= bit;
+        else
+            piece_rows[overlay[i].y] |= bit;
+    }
+
+    // Le lot en attente appartient à la cible courante
+    render_flush(renderer);
+
+    if (renderer->board_mode == BOARD_MODE_STREAMING &&
+        board_draw_streaming(renderer, game, piece_rows, ghost_rows))
+        return;
+
+    if (!board_draw_target(renderer, game, piece_rows, ghost_rows))
+    {
+        board_draw_direct(renderer, game);
+    }
+}
+
+/*
+ * Choisit la façon de dessiner la grille
+ */
+void render_set_board_mode(Renderer *renderer, BoardMode mode)
+{
+    if (renderer == NULL)
+        return;
+
+    renderer->board_mode = mode;
+    board_mark_all_dirty(renderer);
 }
 
 /*
  * Dessine la prochaine pièce
  */
-void render_next_piece(Renderer *renderer, Piece *piece)
+void render_next_piece(Renderer *renderer, const Piece *piece)
 {
     if (renderer == NULL || piece == NULL)
         return;
 
+    // Titre et cadre: dessinés une fois dans le décor
     int offset_x = 550;
     int offset_y = 150;
 
-    // Titre "NEXT"
-    SDL_SetRenderDrawColor(renderer->renderer, 255, 255, 255, 255);
-    SDL_Rect title_rect = {offset_x, offset_y - 30, 80, 20}; // ✅ SDL_Rect
-    SDL_RenderDrawRect(renderer->renderer, &title_rect);     // ✅ SDL_RenderDrawRect
-
-    // Cadre
-    SDL_Rect frame = {offset_x - 10, offset_y - 10, 120, 120}; // ✅ SDL_Rect
-    SDL_RenderDrawRect(renderer->renderer, &frame);            // ✅ SDL_RenderDrawRect
-
     // Dessiner la pièce
-    Block *current = piece->blocks->head;
-    while (current != NULL)
+    for (int i = 0; i < PIECE_BLOCKS; i++)
     {
-        int px = offset_x + (current->x - 3) * 20;
-        int py = offset_y + current->y * 20;
+        int px = offset_x + (piece->x + piece->cells[i].x - 3) * 20;
+        int py = offset_y + (piece->y + piece->cells[i].y) * 20;
 
-        SDL_SetRenderDrawColor(renderer->renderer,
-                               current->color.r,
-                               current->color.g,
-                               current->color.b,
-                               255);
-        SDL_Rect rect = {px, py, 18, 18}; // ✅ SDL_Rect
-        SDL_RenderFillRect(renderer->renderer, &rect);
-
-        current = current->next;
+        SDL_Color fill = {piece->color.r, piece->color.g, piece->color.b, 255};
+        batch_push_rect(renderer, px, py, 18, 18, fill);
     }
 }
 
 /*
- * Dessine l'interface utilisateur (score, niveau, etc.)
+ * Dessine l'affichage des performances: durée des dernières frames en
+ * barres (rouge au-delà de 1/60 s), puis les compteurs
  */
-void render_ui(Renderer *renderer, GameState *game)
+static void draw_perf_hud(Renderer *renderer, const PerfStats *perf)
 {
-    if (renderer == NULL || game == NULL)
+    SDL_Color panel = {0, 0, 0, 180};
+    SDL_Color ok = {80, 220, 80, 255};
+    SDL_Color late = {230, 60, 60, 255};
+    SDL_Color white = {255, 255, 255, 255};
+    float budget_ms = 1000.0f / 60.0f;
+
+    batch_push_rect(renderer, HUD_X, HUD_Y, HUD_WIDTH, HUD_HEIGHT, panel);
+
+    // Barres: la plus ancienne à gauche
+    int base_y = HUD_Y + HUD_HEIGHT - 10;
+    int bar_x = HUD_X + 10 + (PERF_HISTORY - perf->history_count);
+    for (int i = 0; i < perf->history_count; i++)
+    {
+        float ms = perf_history(perf, i);
+        int h = (int)(ms * HUD_BAR_HEIGHT / HUD_BAR_MS);
+        if (h > HUD_BAR_HEIGHT)
+            h = HUD_BAR_HEIGHT;
+        if (h < 1)
+            h = 1;
+        batch_push_rect(renderer, bar_x + i, base_y - h, 1, h, ms > budget_ms ? late : ok);
+    }
+
+    // Ligne de budget (1/60 s)
+    int budget_h = (int)(budget_ms * HUD_BAR_HEIGHT / HUD_BAR_MS);
+    batch_push_rect(renderer, HUD_X + 10, base_y - budget_h, PERF_HISTORY, 1, white);
+
+    if (renderer->font_small == NULL)
         return;
 
-    SDL_SetRenderDrawColor(renderer->renderer, 255, 255, 255, 255);
+    char line[64];
+    int y = HUD_Y + 8;
 
-    // Zone Score
-    SDL_Rect score_frame = {50, 100, 150, 80};            // ✅ SDL_Rect
-    SDL_RenderDrawRect(renderer->renderer, &score_frame); // ✅ SDL_RenderDrawRect
+    snprintf(line, sizeof(line), "FPS %.1f  p99 %.1f ms", perf_fps(perf), perf_p99_ms(perf));
+    render_text_glyphs(renderer, line, HUD_X + 10, y, white, renderer->font_small);
+    y += 20;
 
-    // Zone Level
-    SDL_Rect level_frame = {50, 200, 150, 80};            // ✅ SDL_Rect
-    SDL_RenderDrawRect(renderer->renderer, &level_frame); // ✅ SDL_RenderDrawRect
+    snprintf(line, sizeof(line), "Simulation %.0f ticks/s", perf->ticks_per_second);
+    render_text_glyphs(renderer, line, HUD_X + 10, y, white, renderer->font_small);
+    y += 20;
+
+    snprintf(line, sizeof(line), "Allocations %d", perf->frame_allocs);
+    render_text_glyphs(renderer, line, HUD_X + 10, y, white, renderer->font_small);
+    y += 20;
+
+    snprintf(line, sizeof(line), "Appels de dessin %d", perf->frame_draw_calls);
+    render_text_glyphs(renderer, line, HUD_X + 10, y, white, renderer->font_small);
+}
 
-    // Zone Lines
-    SDL_Rect lines_frame = {50, 300, 150, 80};            // ✅ SDL_Rect
-    SDL_RenderDrawRect(renderer->renderer, &lines_frame); // ✅ SDL_RenderDrawRect
+/*
+ * Dessine l'interface utilisateur (score, niveau, etc.)
+ *
+ * Les cadres font partie du décor (render_background)
+ */
+void render_ui(Renderer *renderer, const GameSnapshot *game)
+{
+    if (renderer == NULL || game == NULL)
+        return;
 
     // Prochaine pièce
-    render_next_piece(renderer, game->next_piece);
+    render_next_piece(renderer, &game->next_piece);
+
+    if (renderer->show_hud && renderer->perf != NULL)
+    {
+        draw_perf_hud(renderer, renderer->perf);
+    }
 }
 
 /*
@@ -449,6 +1421,7 @@ void render_digit(Renderer *renderer, int digit, int x, int y, int size)
     for (int i = 0; i < count; i++)
     {
         SDL_RenderFillRect(renderer->renderer, &rects[i]);
+        renderer->draw_calls++;
     }
 }
 
@@ -565,37 +1538,39 @@ void render_text(Renderer *renderer, const char *text, int x, int y,
     if (renderer == NULL || text == NULL || font == NULL)
         return;
 
-    SDL_Surface *surface = TTF_RenderText_Solid(font, text, color);
-    if (surface == NULL)
-    {
+    render_flush(renderer); // Le texte passe par-dessus les blocs
+    text_draw(&renderer->text, font, text, x, y, color);
+}
+
+/*
+ * Dessine un texte variable depuis l'atlas de glyphes
+ */
+void render_text_glyphs(Renderer *renderer, const char *text, int x, int y,
+                        SDL_Color color, TTF_Font *font)
+{
+    if (renderer == NULL || text == NULL || font == NULL)
         return;
-    }
 
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer->renderer, surface);
-    if (texture == NULL)
+    render_flush(renderer);
+    if (!text_draw_glyphs(&renderer->text, font, text, x, y, color))
     {
-        SDL_FreeSurface(surface);
-        return;
+        text_draw(&renderer->text, font, text, x, y, color);
     }
-
-    SDL_Rect dest = {x, y, surface->w, surface->h};
-    SDL_RenderCopy(renderer->renderer, texture, NULL, &dest);
-
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
 }
 /*
- * Affiche l'écran de game over avec du vrai texte
+ * Dessine l'écran de game over avec du vrai texte
+ *
+ * Retour: false si les polices manquent (panneau sans texte)
  */
-void render_game_over(Renderer *renderer, GameState *game)
+static bool draw_game_over(Renderer *renderer, const GameSnapshot *game)
 {
-    if (renderer == NULL)
-        return;
+    render_flush(renderer); // L'overlay recouvre les blocs
 
     // Fond semi-transparent
     SDL_SetRenderDrawColor(renderer->renderer, 0, 0, 0, 230);
     SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
     SDL_RenderFillRect(renderer->renderer, &overlay);
+    renderer->draw_calls++;
 
     // Panneau principal
     int panel_width = 500;
@@ -607,6 +1582,7 @@ void render_game_over(Renderer *renderer, GameState *game)
     SDL_SetRenderDrawColor(renderer->renderer, 40, 40, 50, 255);
     SDL_Rect panel = {panel_x, panel_y, panel_width, panel_height};
     SDL_RenderFillRect(renderer->renderer, &panel);
+    renderer->draw_calls++;
 
     // Bordure rouge
     SDL_SetRenderDrawColor(renderer->renderer, 255, 0, 0, 255);
@@ -614,6 +1590,7 @@ void render_game_over(Renderer *renderer, GameState *game)
     {
         SDL_Rect border = {panel_x + i, panel_y + i, panel_width - 2 * i, panel_height - 2 * i};
         SDL_RenderDrawRect(renderer->renderer, &border);
+        renderer->draw_calls++;
     }
 
     // Si les polices ne sont pas chargées, afficher des rectangles
@@ -622,12 +1599,8 @@ void render_game_over(Renderer *renderer, GameState *game)
         SDL_SetRenderDrawColor(renderer->renderer, 255, 0, 0, 255);
         SDL_Rect title = {panel_x + 100, panel_y + 40, 300, 60};
         SDL_RenderFillRect(renderer->renderer, &title);
-
-        printf("\n=== GAME OVER ===\n");
-        printf("Score final: %d\n", game->score);
-        printf("Niveau atteint: %d\n", game->level);
-        printf("Lignes complétées: %d\n", game->lines_cleared);
-        return;
+        renderer->draw_calls++;
+        return false;
     }
 
     // ✅ TITRE "GAME OVER"
@@ -638,6 +1611,7 @@ void render_game_over(Renderer *renderer, GameState *game)
     SDL_SetRenderDrawColor(renderer->renderer, 255, 255, 255, 255);
     SDL_Rect sep = {panel_x + 50, panel_y + 110, panel_width - 100, 2};
     SDL_RenderFillRect(renderer->renderer, &sep);
+    renderer->draw_calls++;
 
     // ✅ SCORE
     int info_y = panel_y + 140;
@@ -648,7 +1622,7 @@ void render_game_over(Renderer *renderer, GameState *game)
 
     char score_str[32];
     snprintf(score_str, sizeof(score_str), "%d", game->score);
-    render_text(renderer, score_str, panel_x + 280, info_y, white, renderer->font);
+    render_text_glyphs(renderer, score_str, panel_x + 280, info_y, white, renderer->font);
 
     // ✅ NIVEAU
     info_y += 50;
@@ -658,7 +1632,7 @@ void render_game_over(Renderer *renderer, GameState *game)
 
     char level_str[32];
     snprintf(level_str, sizeof(level_str), "%d", game->level);
-    render_text(renderer, level_str, panel_x + 280, info_y, white, renderer->font);
+    render_text_glyphs(renderer, level_str, panel_x + 280, info_y, white, renderer->font);
 
     // ✅ LIGNES
     info_y += 50;
@@ -668,7 +1642,7 @@ void render_game_over(Renderer *renderer, GameState *game)
 
     char lines_str[32];
     snprintf(lines_str, sizeof(lines_str), "%d", game->lines_cleared);
-    render_text(renderer, lines_str, panel_x + 280, info_y, white, renderer->font);
+    render_text_glyphs(renderer, lines_str, panel_x + 280, info_y, white, renderer->font);
 
     // ✅ INSTRUCTIONS
     info_y += 80;
@@ -679,17 +1653,37 @@ void render_game_over(Renderer *renderer, GameState *game)
     SDL_Color gray = {200, 200, 200, 255};
     render_text(renderer, "ou  ESC  pour quitter", panel_x + 110, info_y + 35, gray, renderer->font);
 
+    return true;
+}
+
+/*
+ * Affiche l'écran de game over (et son résumé dans la console)
+ */
+void render_game_over(Renderer *renderer, const GameSnapshot *game)
+{
+    if (renderer == NULL)
+        return;
+
+    if (!draw_game_over(renderer, game))
+    {
+        log_write(LOG_INFO, "\n=== GAME OVER ===\n");
+        log_write(LOG_INFO, "Score final: %d\n", game->score);
+        log_write(LOG_INFO, "Niveau atteint: %d\n", game->level);
+        log_write(LOG_INFO, "Lignes complétées: %d\n", game->lines_cleared);
+        return;
+    }
+
     // Console backup
-    printf("\n╔════════════════════════════════╗\n");
-    printf("║       GAME OVER                ║\n");
-    printf("╠════════════════════════════════╣\n");
-    printf("║  Score final: %-16d ║\n", game->score);
-    printf("║  Niveau atteint: %-13d ║\n", game->level);
-    printf("║  Lignes complétées: %-10d ║\n", game->lines_cleared);
-    printf("╠════════════════════════════════╣\n");
-    printf("║  [R] Rejouer                   ║\n");
-    printf("║  [ESC] Quitter                 ║\n");
-    printf("╚════════════════════════════════╝\n");
+    log_write(LOG_INFO, "\n╔════════════════════════════════╗\n");
+    log_write(LOG_INFO, "║       GAME OVER                ║\n");
+    log_write(LOG_INFO, "╠════════════════════════════════╣\n");
+    log_write(LOG_INFO, "║  Score final: %-16d ║\n", game->score);
+    log_write(LOG_INFO, "║  Niveau atteint: %-13d ║\n", game->level);
+    log_write(LOG_INFO, "║  Lignes complétées: %-10d ║\n", game->lines_cleared);
+    log_write(LOG_INFO, "╠════════════════════════════════╣\n");
+    log_write(LOG_INFO, "║  [R] Rejouer                   ║\n");
+    log_write(LOG_INFO, "║  [ESC] Quitter                 ║\n");
+    log_write(LOG_INFO, "╚════════════════════════════════╝\n");
 }
 /*
  * Affiche le message de pause
@@ -699,9 +1693,12 @@ void render_pause(Renderer *renderer)
     if (renderer == NULL)
         return;
 
+    render_flush(renderer); // L'overlay recouvre les blocs
+
     SDL_SetRenderDrawColor(renderer->renderer, 0, 0, 0, 150);
     SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT}; // ✅ SDL_Rect
     SDL_RenderFillRect(renderer->renderer, &overlay);
+    renderer->draw_calls++;
 
     SDL_SetRenderDrawColor(renderer->renderer, 255, 255, 0, 255);
     SDL_Rect pause_frame = {// ✅ SDL_Rect
@@ -710,4 +1707,43 @@ void render_pause(Renderer *renderer)
                             200,
                             60};
     SDL_RenderDrawRect(renderer->renderer, &pause_frame); // ✅ SDL_RenderDrawRect
-}
\ No newline at end of file
+    renderer->draw_calls++;
+}
+
+/*
+ * Crée d'avance ce que les écrans occasionnels créeraient au premier
+ * affichage, en les dessinant une fois sans les présenter
+ */
+void render_prewarm(Renderer *renderer)
+{
+    if (renderer == NULL)
+        return;
+
+    GameSnapshot empty;
+    PerfStats no_perf;
+    memset(&empty, 0, sizeof(empty));
+    memset(&no_perf, 0, sizeof(no_perf));
+
+    // Game over: atlas de la police et libellés dans le cache de
+    // chaînes. Perfs: atlas de la petite police.
+    draw_game_over(renderer, &empty);
+    draw_perf_hud(renderer, &no_perf);
+
+    // Effacer: rien de tout cela n'est présenté
+    render_flush(renderer);
+    render_clear(renderer);
+    renderer->draw_calls = 0;
+    renderer->text.draw_calls = 0;
+
+    // File d'événements: SDL garde les cases libérées et les réutilise,
+    // une rafale d'entrées ne l'oblige plus à en allouer
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = SDL_USEREVENT;
+    for (int i = 0; i < RENDER_PREWARM_EVENTS; i++)
+    {
+        if (SDL_PushEvent(&event) <= 0)
+            break;
+    }
+    SDL_FlushEvent(SDL_USEREVENT);
+}
@@ -0,0 +1,82 @@
+/*
+ * rng.c - xoshiro256** et initialisation par splitmix64
+ */
+
+#include "include/rng.h"
+#include <stddef.h>
+
+/*
+ * Rotation à gauche sur 64 bits
+ */
+static uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/*
+ * Étape de splitmix64 (initialisation de l'état)
+ */
+static uint64_t splitmix64(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/*
+ * Initialise le générateur
+ */
+void rng_seed(Rng *rng, uint64_t seed)
+{
+    if (rng == NULL)
+        return;
+
+    for (int i = 0; i < 4; i++)
+    {
+        rng->s[i] = splitmix64(&seed);
+    }
+}
+
+/*
+ * Tire 64 bits
+ */
+uint64_t rng_next(Rng *rng)
+{
+    uint64_t *s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+}
+
+/*
+ * Tire un entier uniforme dans [0, bound)
+ */
+uint32_t rng_below(Rng *rng, uint32_t bound)
+{
+    // Les 32 bits de poids fort (les meilleurs) multipliés par la borne:
+    // la partie haute est le résultat
+    uint64_t m = (rng_next(rng) >> 32) * (uint64_t)bound;
+    uint32_t low = (uint32_t)m;
+
+    // Rejeter les quelques valeurs qui biaiseraient le résultat
+    if (low < bound)
+    {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold)
+        {
+            m = (rng_next(rng) >> 32) * (uint64_t)bound;
+            low = (uint32_t)m;
+        }
+    }
+
+    return (uint32_t)(m >> 32);
+}
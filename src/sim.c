@@ -0,0 +1,327 @@
+/*
+ * sim.c - Thread de simulation, file de commandes et triple tampon
+ */
+
+#include "include/sim.h"
+#include "include/alloc.h"
+#include "include/profile.h"
+#include "include/trace.h"
+#include "include/log.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Applique une commande du joueur (thread de simulation)
+ */
+static void sim_apply(GameState *game, SimCommand command)
+{
+    // Game over: seule la nouvelle partie est acceptée
+    if (game->game_over && command != SIM_CMD_RESET)
+        return;
+
+    switch (command)
+    {
+    case SIM_CMD_LEFT:
+        game_move_piece(game, -1, 0);
+        break;
+
+    case SIM_CMD_RIGHT:
+        game_move_piece(game, 1, 0);
+        break;
+
+    case SIM_CMD_SOFT_DROP:
+        if (game_move_piece(game, 0, 1))
+        {
+            game->score += 1; // Petit bonus
+        }
+        break;
+
+    case SIM_CMD_ROTATE_CW:
+        game_rotate_piece(game, ROTATE_CW);
+        break;
+
+    case SIM_CMD_ROTATE_CCW:
+        game_rotate_piece(game, ROTATE_CCW);
+        break;
+
+    case SIM_CMD_ROTATE_180:
+        game_rotate_piece(game, ROTATE_180);
+        break;
+
+    case SIM_CMD_HARD_DROP:
+        game_drop_piece(game);
+        break;
+
+    case SIM_CMD_PAUSE:
+        game_toggle_pause(game);
+        log_write(LOG_INFO, game->paused ? "=== PAUSE ===\n" : "=== REPRISE ===\n");
+        break;
+
+    case SIM_CMD_RESET:
+        game_reset(game);
+        log_write(LOG_INFO, "Nouvelle partie!\n");
+        break;
+    }
+}
+
+/*
+ * Applique toutes les commandes en attente
+ *
+ * Retour: true si au moins une commande a été appliquée
+ */
+static bool sim_drain(Simulation *sim)
+{
+    int tail = SDL_AtomicGet(&sim->cmd_tail);
+    int head = SDL_AtomicGet(&sim->cmd_head);
+
+    if (tail == head)
+        return false;
+
+    // Les cases jusqu'à head sont lues après leur publication
+    SDL_MemoryBarrierAcquire();
+
+    while (tail != head)
+    {
+        sim_apply(sim->game, (SimCommand)sim->commands[tail]);
+        tail = (tail + 1) % SIM_QUEUE_SIZE;
+    }
+
+    // Libère les cases lues pour le producteur (lectures terminées
+    // avant que la nouvelle queue soit visible)
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&sim->cmd_tail, tail);
+    return true;
+}
+
+/*
+ * Écrit un instantané dans le tampon du producteur
+ */
+static void sim_snapshot(Simulation *sim, GameSnapshot *snapshot)
+{
+    GridRow dirty[GRID_HEIGHT];
+    GridRow any = 0;
+
+    game_snapshot(sim->game, snapshot);
+
+    game_take_dirty(sim->game, dirty);
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        any |= dirty[y];
+    }
+    if (any != 0)
+    {
+        sim->grid_version++;
+    }
+    snapshot->grid_version = sim->grid_version;
+    snapshot->sequence = ++sim->sequence;
+}
+
+/*
+ * Publie l'état courant: le tampon écrit devient le dernier, l'ancien
+ * dernier devient le nouveau tampon du producteur
+ */
+static void sim_publish(Simulation *sim)
+{
+    GameSnapshot *snapshot = &sim->buffers[sim->back];
+    sim_snapshot(sim, snapshot);
+    bool idle = snapshot->paused || snapshot->game_over;
+
+    // L'instantané est entièrement écrit avant l'échange: SDL_AtomicSet
+    // n'est qu'une barrière d'acquisition sur certains processeurs (ARM)
+    SDL_MemoryBarrierRelease();
+    sim->back = SDL_AtomicSet(&sim->latest, sim->back | SIM_SNAPSHOT_FRESH) &
+                SIM_SNAPSHOT_INDEX;
+
+    // Entrée ou sortie de veille: réveiller le thread SDL s'il attend
+    if (idle != sim->idle && sim->event_type != 0)
+    {
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = sim->event_type;
+        SDL_PushEvent(&event);
+    }
+    sim->idle = idle;
+}
+
+/*
+ * Boucle du thread de simulation
+ *
+ * Attend la prochaine échéance de tick ou une commande (sémaphore),
+ * applique les commandes, exécute les ticks dus, puis publie si
+ * quelque chose a changé.
+ */
+static int sim_thread(void *data)
+{
+    Simulation *sim = (Simulation *)data;
+    Uint64 perf_freq = SDL_GetPerformanceFrequency();
+    Uint64 clock_start = SDL_GetPerformanceCounter();
+    Uint64 ticks_done = 0;
+
+    while (SDL_AtomicGet(&sim->running))
+    {
+        bool changed = sim_drain(sim);
+
+        // Nombre de ticks dus depuis le lancement
+        Uint64 elapsed = SDL_GetPerformanceCounter() - clock_start;
+        Uint64 ticks_due = elapsed * SIM_TICK_RATE / perf_freq;
+        Uint64 ticks = ticks_due - ticks_done;
+        if (ticks > SIM_MAX_CATCHUP_TICKS)
+        {
+            ticks = SIM_MAX_CATCHUP_TICKS;
+        }
+        ticks_done = ticks_due;
+
+        if (ticks > 0)
+        {
+            PHASE_BEGIN(PROFILE_UPDATE);
+            game_update(sim->game, (int)ticks);
+            PHASE_END(PROFILE_UPDATE);
+            changed = true;
+        }
+
+        if (changed)
+        {
+            sim_publish(sim);
+        }
+
+        // Pause ou game over: rien à simuler, dormir jusqu'à la
+        // prochaine commande (ou l'arrêt). Le temps passé en veille
+        // n'est pas rattrapé.
+        if (sim->game->paused || sim->game->game_over)
+        {
+            SDL_SemWait(sim->wake);
+            elapsed = SDL_GetPerformanceCounter() - clock_start;
+            ticks_done = elapsed * SIM_TICK_RATE / perf_freq;
+            continue;
+        }
+
+        // Dormir jusqu'au prochain tick (arrondi au-dessus), ou jusqu'à
+        // la prochaine commande
+        Uint64 next_tick = clock_start + (ticks_due + 1) * perf_freq / SIM_TICK_RATE;
+        Uint64 now = SDL_GetPerformanceCounter();
+        Uint32 wait_ms = 0;
+        if (next_tick > now)
+        {
+            wait_ms = (Uint32)(((next_tick - now) * 1000 + perf_freq - 1) / perf_freq);
+        }
+        SDL_SemWaitTimeout(sim->wake, wait_ms);
+    }
+
+    return 0;
+}
+
+/*
+ * Lance le thread de simulation
+ */
+Simulation *sim_start(GameState *game)
+{
+    if (game == NULL)
+        return NULL;
+
+    Simulation *sim = (Simulation *)alloc_malloc(sizeof(Simulation));
+    if (sim == NULL)
+    {
+        fprintf(stderr, "Erreur: Impossible d'allouer la simulation\n");
+        return NULL;
+    }
+
+    sim->game = game;
+    sim->grid_version = 0;
+    sim->sequence = 0;
+    sim->idle = false;
+
+    // Événement de changement de veille ((Uint32)-1: plus d'événements libres)
+    sim->event_type = SDL_RegisterEvents(1);
+    if (sim->event_type == (Uint32)-1)
+    {
+        sim->event_type = 0;
+    }
+
+    SDL_AtomicSet(&sim->cmd_head, 0);
+    SDL_AtomicSet(&sim->cmd_tail, 0);
+
+    // Les trois tampons partent du même état: le lecteur a toujours
+    // un instantané valide
+    sim_snapshot(sim, &sim->buffers[0]);
+    sim->buffers[1] = sim->buffers[0];
+    sim->buffers[2] = sim->buffers[0];
+    sim->front = 0;
+    SDL_AtomicSet(&sim->latest, 1);
+    sim->back = 2;
+
+    sim->wake = SDL_CreateSemaphore(0);
+    if (sim->wake == NULL)
+    {
+        fprintf(stderr, "Erreur SDL_CreateSemaphore: %s\n", SDL_GetError());
+        alloc_free(sim);
+        return NULL;
+    }
+
+    SDL_AtomicSet(&sim->running, 1);
+    sim->thread = SDL_CreateThread(sim_thread, "simulation", sim);
+    if (sim->thread == NULL)
+    {
+        fprintf(stderr, "Erreur SDL_CreateThread: %s\n", SDL_GetError());
+        SDL_DestroySemaphore(sim->wake);
+        alloc_free(sim);
+        return NULL;
+    }
+
+    return sim;
+}
+
+/*
+ * Arrête le thread et libère la simulation
+ */
+void sim_stop(Simulation *sim)
+{
+    if (sim == NULL)
+        return;
+
+    SDL_AtomicSet(&sim->running, 0);
+    SDL_SemPost(sim->wake);
+    SDL_WaitThread(sim->thread, NULL);
+
+    SDL_DestroySemaphore(sim->wake);
+    alloc_free(sim);
+}
+
+/*
+ * Envoie une commande (thread SDL)
+ */
+bool sim_push(Simulation *sim, SimCommand command)
+{
+    if (sim == NULL)
+        return false;
+
+    int head = SDL_AtomicGet(&sim->cmd_head);
+    int next = (head + 1) % SIM_QUEUE_SIZE;
+    if (next == SDL_AtomicGet(&sim->cmd_tail))
+        return false; // File pleine
+
+    // La case libérée par le consommateur a fini d'être lue
+    SDL_MemoryBarrierAcquire();
+
+    // La commande est écrite avant que la nouvelle tête soit visible
+    sim->commands[head] = (Uint8)command;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&sim->cmd_head, next);
+    SDL_SemPost(sim->wake);
+    return true;
+}
+
+/*
+ * Dernier instantané publié (thread SDL)
+ */
+const GameSnapshot *sim_latest(Simulation *sim)
+{
+    // Nouvel instantané? Échanger son tampon contre celui du lecteur
+    if (SDL_AtomicGet(&sim->latest) & SIM_SNAPSHOT_FRESH)
+    {
+        sim->front = SDL_AtomicSet(&sim->latest, sim->front) & SIM_SNAPSHOT_INDEX;
+
+        // Le contenu du tampon obtenu est lu après l'échange
+        SDL_MemoryBarrierAcquire();
+    }
+    return &sim->buffers[sim->front];
+}
@@ -0,0 +1,350 @@
+/*
+ * text.c - Atlas de glyphes et cache de textures de chaînes
+ */
+
+#include "include/text.h"
+#include <string.h>
+
+/*
+ * Hachage FNV-1a de la clé (police, texte, couleur)
+ */
+static uint32_t key_hash(TTF_Font *font, const char *text, SDL_Color color)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)text; *p != '\0'; p++)
+    {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    uint64_t f = (uint64_t)(uintptr_t)font;
+    hash = (hash ^ (uint32_t)(f ^ (f >> 32))) * 16777619u;
+    uint32_t c = ((uint32_t)color.r << 24) | ((uint32_t)color.g << 16) |
+                 ((uint32_t)color.b << 8) | color.a;
+    return (hash ^ c) * 16777619u;
+}
+
+/*
+ * Rastérise les glyphes ASCII imprimables de la police dans une texture
+ *
+ * Retour: true si l'atlas est prêt
+ */
+static bool atlas_build(TextCache *cache, GlyphAtlas *atlas, TTF_Font *font)
+{
+    SDL_Surface *glyphs[TEXT_GLYPH_COUNT];
+    SDL_Color white = {255, 255, 255, 255};
+    int width = 0;
+    int height = 0;
+
+    atlas->font = font;
+    atlas->texture = NULL;
+
+    // Rendre chaque glyphe séparément pour connaître la taille totale
+    for (int i = 0; i < TEXT_GLYPH_COUNT; i++)
+    {
+        Uint16 ch = (Uint16)(TEXT_GLYPH_FIRST + i);
+        int advance = 0;
+
+        if (TTF_GlyphMetrics(font, ch, NULL, NULL, NULL, NULL, &advance) != 0)
+        {
+            advance = 0;
+        }
+        atlas->advances[i] = advance;
+
+        glyphs[i] = TTF_RenderGlyph_Blended(font, ch, white);
+        if (glyphs[i] != NULL)
+        {
+            width += glyphs[i]->w + 1; // 1 pixel vide entre deux glyphes
+            if (glyphs[i]->h > height)
+            {
+                height = glyphs[i]->h;
+            }
+        }
+    }
+
+    SDL_Surface *sheet = NULL;
+    if (width > 0 && height > 0)
+    {
+        sheet = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32,
+                                               SDL_PIXELFORMAT_RGBA32);
+    }
+
+    // Copier les glyphes côte à côte (alpha compris, sans mélange)
+    int pen = 0;
+    for (int i = 0; i < TEXT_GLYPH_COUNT; i++)
+    {
+        atlas->glyphs[i] = (SDL_Rect){0, 0, 0, 0};
+        if (glyphs[i] == NULL)
+            continue;
+
+        if (sheet != NULL)
+        {
+            SDL_Rect dest = {pen, 0, glyphs[i]->w, glyphs[i]->h};
+            SDL_SetSurfaceBlendMode(glyphs[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(glyphs[i], NULL, sheet, &dest);
+            atlas->glyphs[i] = dest;
+            pen += glyphs[i]->w + 1;
+        }
+        SDL_FreeSurface(glyphs[i]);
+    }
+
+    if (sheet == NULL)
+    {
+        return false;
+    }
+
+    atlas->texture = SDL_CreateTextureFromSurface(cache->renderer, sheet);
+    SDL_FreeSurface(sheet);
+    if (atlas->texture == NULL)
+    {
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+    atlas->width = width;
+    atlas->height = height;
+    return true;
+}
+
+/*
+ * Retourne l'atlas de la police, construit au premier appel
+ *
+ * Retour: NULL si l'atlas n'existe pas et ne peut pas être construit
+ * (un échec n'est pas retenté: la police garde son entrée vide)
+ */
+static GlyphAtlas *atlas_for_font(TextCache *cache, TTF_Font *font)
+{
+    GlyphAtlas *free_atlas = NULL;
+
+    for (int i = 0; i < TEXT_MAX_FONTS; i++)
+    {
+        GlyphAtlas *atlas = &cache->atlases[i];
+        if (atlas->font == font)
+        {
+            return atlas->texture != NULL ? atlas : NULL;
+        }
+        if (atlas->font == NULL && free_atlas == NULL)
+        {
+            free_atlas = atlas;
+        }
+    }
+
+    if (free_atlas == NULL || !atlas_build(cache, free_atlas, font))
+    {
+        return NULL;
+    }
+    return free_atlas;
+}
+
+/*
+ * Rend une chaîne et la dessine sans la garder (clé trop longue)
+ */
+static void draw_uncached(TextCache *cache, TTF_Font *font, const char *text,
+                          int x, int y, SDL_Color color)
+{
+    SDL_Surface *surface = TTF_RenderUTF8_Solid(font, text, color);
+    if (surface == NULL)
+        return;
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(cache->renderer, surface);
+    if (texture != NULL)
+    {
+        SDL_Rect dest = {x, y, surface->w, surface->h};
+        SDL_RenderCopy(cache->renderer, texture, NULL, &dest);
+        cache->draw_calls++;
+        SDL_DestroyTexture(texture);
+    }
+    SDL_FreeSurface(surface);
+}
+
+/*
+ * Initialise un cache vide
+ */
+void text_cache_init(TextCache *cache, SDL_Renderer *renderer)
+{
+    if (cache == NULL)
+        return;
+
+    memset(cache->atlases, 0, sizeof(cache->atlases));
+    memset(cache->entries, 0, sizeof(cache->entries));
+    cache->renderer = renderer;
+    cache->clock = 0;
+    cache->draw_calls = 0;
+
+    // Indices des quads: fixes (0-1-2, 0-2-3 par glyphe)
+    for (int q = 0; q < TEXT_MAX_GLYPHS; q++)
+    {
+        int *idx = &cache->indices[q * 6];
+        idx[0] = q * 4;
+        idx[1] = q * 4 + 1;
+        idx[2] = q * 4 + 2;
+        idx[3] = q * 4;
+        idx[4] = q * 4 + 2;
+        idx[5] = q * 4 + 3;
+    }
+}
+
+/*
+ * Libère les textures des atlas et des chaînes
+ */
+void text_cache_destroy(TextCache *cache)
+{
+    if (cache == NULL)
+        return;
+
+    for (int i = 0; i < TEXT_MAX_FONTS; i++)
+    {
+        if (cache->atlases[i].texture != NULL)
+        {
+            SDL_DestroyTexture(cache->atlases[i].texture);
+        }
+        cache->atlases[i].texture = NULL;
+        cache->atlases[i].font = NULL;
+    }
+
+    for (int i = 0; i < TEXT_CACHE_SLOTS; i++)
+    {
+        if (cache->entries[i].texture != NULL)
+        {
+            SDL_DestroyTexture(cache->entries[i].texture);
+        }
+        cache->entries[i].texture = NULL;
+        cache->entries[i].font = NULL;
+    }
+}
+
+/*
+ * Dessine un libellé via le cache de chaînes (LRU)
+ */
+void text_draw(TextCache *cache, TTF_Font *font, const char *text,
+               int x, int y, SDL_Color color)
+{
+    if (cache == NULL || font == NULL || text == NULL)
+        return;
+
+    if (strlen(text) >= TEXT_CACHE_MAX_LEN)
+    {
+        draw_uncached(cache, font, text, x, y, color);
+        return;
+    }
+
+    uint32_t hash = key_hash(font, text, color);
+    TextCacheEntry *victim = NULL;
+
+    for (int i = 0; i < TEXT_CACHE_SLOTS; i++)
+    {
+        TextCacheEntry *entry = &cache->entries[i];
+
+        if (entry->font == font && entry->hash == hash &&
+            entry->color.r == color.r && entry->color.g == color.g &&
+            entry->color.b == color.b && entry->color.a == color.a &&
+            strcmp(entry->text, text) == 0)
+        {
+            // Trouvé: simple copie de texture
+            entry->last_used = ++cache->clock;
+            SDL_Rect dest = {x, y, entry->w, entry->h};
+            SDL_RenderCopy(cache->renderer, entry->texture, NULL, &dest);
+            cache->draw_calls++;
+            return;
+        }
+
+        // Candidat à l'éviction: entrée libre, sinon la plus ancienne
+        if (victim == NULL ||
+            (victim->font != NULL &&
+             (entry->font == NULL || entry->last_used < victim->last_used)))
+        {
+            victim = entry;
+        }
+    }
+
+    // Absent: rastériser la chaîne et remplacer l'entrée choisie
+    SDL_Surface *surface = TTF_RenderUTF8_Solid(font, text, color);
+    if (surface == NULL)
+        return;
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(cache->renderer, surface);
+    int w = surface->w;
+    int h = surface->h;
+    SDL_FreeSurface(surface);
+    if (texture == NULL)
+        return;
+
+    if (victim->texture != NULL)
+    {
+        SDL_DestroyTexture(victim->texture);
+    }
+
+    victim->font = font;
+    victim->color = color;
+    victim->hash = hash;
+    strcpy(victim->text, text);
+    victim->texture = texture;
+    victim->w = w;
+    victim->h = h;
+    victim->last_used = ++cache->clock;
+
+    SDL_Rect dest = {x, y, w, h};
+    SDL_RenderCopy(cache->renderer, texture, NULL, &dest);
+    cache->draw_calls++;
+}
+
+/*
+ * Dessine un texte glyphe par glyphe depuis l'atlas de la police
+ */
+bool text_draw_glyphs(TextCache *cache, TTF_Font *font, const char *text,
+                      int x, int y, SDL_Color color)
+{
+    if (cache == NULL || font == NULL || text == NULL)
+        return false;
+
+    GlyphAtlas *atlas = atlas_for_font(cache, font);
+    if (atlas == NULL)
+        return false;
+
+    float inv_w = 1.0f / (float)atlas->width;
+    float inv_h = 1.0f / (float)atlas->height;
+    int pen = x;
+    int quads = 0;
+
+    for (const unsigned char *p = (const unsigned char *)text; *p != '\0'; p++)
+    {
+        if (*p < TEXT_GLYPH_FIRST || *p > TEXT_GLYPH_LAST)
+            continue;
+
+        int i = *p - TEXT_GLYPH_FIRST;
+        const SDL_Rect *g = &atlas->glyphs[i];
+
+        if (g->w > 0)
+        {
+            if (quads == TEXT_MAX_GLYPHS)
+            {
+                SDL_RenderGeometry(cache->renderer, atlas->texture,
+                                   cache->vertices, quads * 4,
+                                   cache->indices, quads * 6);
+                cache->draw_calls++;
+                quads = 0;
+            }
+
+            SDL_Vertex *v = &cache->vertices[quads * 4];
+            float x0 = (float)pen, y0 = (float)y;
+            float x1 = (float)(pen + g->w), y1 = (float)(y + g->h);
+            float u0 = g->x * inv_w, v0 = g->y * inv_h;
+            float u1 = (g->x + g->w) * inv_w, v1 = (g->y + g->h) * inv_h;
+
+            v[0] = (SDL_Vertex){{x0, y0}, color, {u0, v0}};
+            v[1] = (SDL_Vertex){{x1, y0}, color, {u1, v0}};
+            v[2] = (SDL_Vertex){{x1, y1}, color, {u1, v1}};
+            v[3] = (SDL_Vertex){{x0, y1}, color, {u0, v1}};
+            quads++;
+        }
+
+        pen += atlas->advances[i];
+    }
+
+    if (quads > 0)
+    {
+        SDL_RenderGeometry(cache->renderer, atlas->texture,
+                           cache->vertices, quads * 4,
+                           cache->indices, quads * 6);
+        cache->draw_calls++;
+    }
+    return true;
+}
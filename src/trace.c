@@ -0,0 +1,197 @@
+/*
+ * trace.c - Tampons de trace et export au format trace_event de Chrome
+ */
+
+#include "include/trace.h"
+#include "include/alloc.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// État de la trace (écrit avant le lancement de la simulation, relu
+// seulement après son arrêt)
+static bool trace_enabled = false;
+static FILE *trace_file = NULL;
+static Uint64 trace_origin;
+static Uint64 trace_freq;
+static Uint64 phase_starts[PROFILE_PHASE_COUNT];
+static TraceRing rings[TRACE_THREAD_COUNT];
+
+static const char *thread_names[TRACE_THREAD_COUNT] = {"main", "simulation"};
+
+// Nom et valeur de chaque GameEvent
+static const char *event_names[] = {"lock", "lines", "game_over", "kick"};
+static const char *event_args[] = {"piece", "lines", "score", "kick"};
+
+/*
+ * Réserve la prochaine case du tampon d'un thread
+ */
+static TraceEvent *ring_push(TraceThread thread)
+{
+    TraceRing *ring = &rings[thread];
+    TraceEvent *event = &ring->events[ring->written % TRACE_CAPACITY];
+    ring->written++;
+    return event;
+}
+
+/*
+ * Date d'un instant en microsecondes depuis l'ouverture de la trace
+ */
+static double to_us(Uint64 counter)
+{
+    return (double)(counter - trace_origin) * 1000000.0 / (double)trace_freq;
+}
+
+/*
+ * Écrit le tampon d'un thread, du plus ancien au plus récent
+ */
+static void ring_write(FILE *file, TraceThread thread)
+{
+    TraceRing *ring = &rings[thread];
+    Uint64 first = (ring->written > TRACE_CAPACITY) ? ring->written - TRACE_CAPACITY : 0;
+
+    for (Uint64 i = first; i < ring->written; i++)
+    {
+        const TraceEvent *event = &ring->events[i % TRACE_CAPACITY];
+
+        if (event->instant)
+        {
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f",
+                    event->name, thread + 1, to_us(event->start));
+        }
+        else
+        {
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+                    event->name, thread + 1, to_us(event->start),
+                    (double)event->duration * 1000000.0 / (double)trace_freq);
+        }
+
+        if (event->arg != NULL)
+        {
+            fprintf(file, ",\"args\":{\"%s\":%d}", event->arg, event->value);
+        }
+        fprintf(file, "}");
+    }
+}
+
+/*
+ * Active la trace
+ */
+bool trace_open(const char *path)
+{
+    if (path == NULL || trace_enabled)
+        return false;
+
+    trace_file = fopen(path, "w");
+    if (trace_file == NULL)
+    {
+        fprintf(stderr, "Erreur: Impossible d'ouvrir %s\n", path);
+        return false;
+    }
+
+    for (int t = 0; t < TRACE_THREAD_COUNT; t++)
+    {
+        rings[t].events = (TraceEvent *)alloc_malloc(TRACE_CAPACITY * sizeof(TraceEvent));
+        rings[t].written = 0;
+        if (rings[t].events == NULL)
+        {
+            fprintf(stderr, "Erreur: Impossible d'allouer la trace\n");
+            for (int u = 0; u < t; u++)
+            {
+                alloc_free(rings[u].events);
+                rings[u].events = NULL;
+            }
+            fclose(trace_file);
+            trace_file = NULL;
+            return false;
+        }
+    }
+
+    trace_freq = SDL_GetPerformanceFrequency();
+    trace_origin = SDL_GetPerformanceCounter();
+    trace_enabled = true;
+    return true;
+}
+
+/*
+ * Écrit la trace et libère les tampons
+ */
+void trace_close(void)
+{
+    if (!trace_enabled)
+        return;
+
+    trace_enabled = false;
+
+    // Noms des threads, puis les événements de chacun
+    fprintf(trace_file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(trace_file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"tetris\"}}");
+    for (int t = 0; t < TRACE_THREAD_COUNT; t++)
+    {
+        fprintf(trace_file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                t + 1, thread_names[t]);
+    }
+    for (int t = 0; t < TRACE_THREAD_COUNT; t++)
+    {
+        ring_write(trace_file, (TraceThread)t);
+    }
+    fprintf(trace_file, "\n]}\n");
+
+    fclose(trace_file);
+    trace_file = NULL;
+
+    for (int t = 0; t < TRACE_THREAD_COUNT; t++)
+    {
+        alloc_free(rings[t].events);
+        rings[t].events = NULL;
+    }
+}
+
+/*
+ * Début d'une phase
+ */
+void trace_begin(ProfilePhase phase)
+{
+    if (!trace_enabled)
+        return;
+
+    phase_starts[phase] = SDL_GetPerformanceCounter();
+}
+
+/*
+ * Fin d'une phase
+ */
+void trace_end(ProfilePhase phase)
+{
+    if (!trace_enabled)
+        return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    TraceThread thread = (phase == PROFILE_UPDATE) ? TRACE_THREAD_SIM : TRACE_THREAD_MAIN;
+    TraceEvent *event = ring_push(thread);
+
+    event->name = profile_phase_name(phase);
+    event->arg = NULL;
+    event->start = phase_starts[phase];
+    event->duration = now - phase_starts[phase];
+    event->value = 0;
+    event->instant = false;
+}
+
+/*
+ * Crochet d'événements du jeu
+ */
+void trace_game_event(void *user, GameEvent event, int value)
+{
+    (void)user;
+
+    if (!trace_enabled)
+        return;
+
+    TraceEvent *record = ring_push(TRACE_THREAD_SIM);
+    record->name = event_names[event];
+    record->arg = event_args[event];
+    record->start = SDL_GetPerformanceCounter();
+    record->duration = 0;
+    record->value = value;
+    record->instant = true;
+}